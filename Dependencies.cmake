@@ -22,4 +22,14 @@ CPMAddPackage(
         GITHUB_REPOSITORY p-ranav/argparse
         GIT_TAG v3.2)
 
-find_package(Python3 REQUIRED COMPONENTS Interpreter)
\ No newline at end of file
+CPMAddPackage(
+        NAME benchmark
+        GITHUB_REPOSITORY google/benchmark
+        GIT_TAG v1.9.4
+        OPTIONS
+        "BENCHMARK_ENABLE_TESTING OFF"
+        "BENCHMARK_ENABLE_GTEST_TESTS OFF"
+        "BENCHMARK_ENABLE_INSTALL OFF")
+
+find_package(Threads REQUIRED)
+find_package(Python3 REQUIRED COMPONENTS Interpreter)
@@ -0,0 +1,16 @@
+// Iterative Fibonacci numbers, a loop carried dependency through two variables.
+
+int main(void) {
+    int sum = 0;
+    for (int n = 0; n < 200000; n = n + 1) {
+        int a = 0;
+        int b = 1;
+        for (int i = 0; i < 40; i = i + 1) {
+            int t = a + b;
+            a = b;
+            b = t & 65535;
+        }
+        sum = sum + a;
+    }
+    return sum & 255;
+}
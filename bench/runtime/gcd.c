@@ -0,0 +1,18 @@
+// Division and remainder in a tight loop.
+
+int main(void) {
+    int sum = 0;
+    for (int i = 1; i < 1500; i = i + 1) {
+        for (int j = 1; j < 1500; j = j + 1) {
+            int a = i;
+            int b = j;
+            while (b != 0) {
+                int t = a % b;
+                a = b;
+                b = t;
+            }
+            sum = sum + a;
+        }
+    }
+    return sum & 255;
+}
@@ -0,0 +1,11 @@
+// Nested counted loops with integer arithmetic.
+
+int main(void) {
+    int sum = 0;
+    for (int i = 0; i < 3000; i = i + 1) {
+        for (int j = 0; j < 3000; j = j + 1) {
+            sum = sum + (i ^ j) - (i & j);
+        }
+    }
+    return sum & 255;
+}
@@ -0,0 +1,16 @@
+// Trial division, with early exits from the inner loop.
+
+int main(void) {
+    int count = 0;
+    for (int n = 2; n < 500000; n = n + 1) {
+        int prime = 1;
+        for (int d = 2; d * d <= n; d = d + 1) {
+            if (n % d == 0) {
+                prime = 0;
+                break;
+            }
+        }
+        count = count + prime;
+    }
+    return count & 255;
+}
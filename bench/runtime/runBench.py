@@ -0,0 +1,255 @@
+#!/usr/bin/env python3
+#
+#  AXC - C Compiler
+#
+#  Copyright (c) 2025.
+#
+
+# Runtime benchmarks of the code axc generates. Each program in the corpus is compiled with axc, assembled and
+# linked with the system cc, run, and its time and instruction count compared with the stored baseline. The exit
+# code is checked against the same program compiled by cc. A program which stops running correctly, or is slower
+# than the baseline by more than the thresholds, is a regression.
+#
+# The corpus only holds programs which axc compiles and runs correctly, so that the baseline has a time and an
+# instruction count for each.
+#
+# Instructions are counted with perf where there are hardware counters. Otherwise, on x86_64, the assembly is
+# instrumented to count the instructions executed in the code axc generated, not those in the C library.
+#
+#   runBench.py --axc build/cmd/axc_comp
+#   runBench.py --axc build/cmd/axc_comp --flags=-O2 --update-baseline
+
+import argparse
+import glob
+import json
+import os
+import platform
+import re
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+CORPUS = os.path.dirname(os.path.abspath(__file__))
+
+
+def run(command, timeout=None):
+    return subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, timeout=timeout)
+
+
+def build(args, source, tmp):
+    """Compile the program with axc and cc, returning the executables, or an error"""
+    name = os.path.splitext(os.path.basename(source))[0]
+    copy = os.path.join(tmp, name + ".c")
+    shutil.copyfile(source, copy)
+
+    # axc writes the assembly next to the input
+    result = run([args.axc, "-s", "--os", args.os, "-m", args.machine] + args.flags.split() + [copy])
+    if result.returncode != 0:
+        return None, None, "compile"
+    program = os.path.join(tmp, name)
+    if run([args.cc, "-o", program, os.path.join(tmp, name + ".s")]).returncode != 0:
+        return None, None, "assemble"
+
+    reference = os.path.join(tmp, name + ".ref")
+    if run([args.cc, "-w", "-O0", "-o", reference, source]).returncode != 0:
+        return None, None, "reference"
+    return program, reference, None
+
+
+def perf_instructions(program, timeout):
+    """User space instructions retired, if perf is available and the machine has the counter"""
+    if shutil.which("perf") is None:
+        return None
+    result = subprocess.run(["perf", "stat", "-x", ",", "-e", "instructions:u", program],
+                            stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True, timeout=timeout)
+    for line in result.stderr.splitlines():
+        fields = line.split(",")
+        if len(fields) > 2 and fields[2].startswith("instructions") and fields[0].isdigit():
+            return int(fields[0])
+    return None
+
+
+# Written by the counting program when it exits. %r15 is not allocated by axc, and is kept by the C library.
+COUNTER = """
+#include <stdio.h>
+long axc_instructions;
+__attribute__((destructor)) static void axc_report(void) { fprintf(stderr, "%ld\\n", axc_instructions); }
+"""
+
+LABEL = re.compile(r"^[.\w]+:")
+BRANCH = re.compile(r"^(j\w+|ret|call)\b")
+
+
+def instrument(assembly):
+    """Count the instructions in x86_64 assembly as it runs: each basic block adds its length to %r15, which is
+    stored on return. lea does not change the flags, so it can go anywhere in a block."""
+    lines = []
+    block = []
+
+    def flush():
+        count = sum(1 for line in block if is_instruction(line))
+        if count:
+            lines.append(f"\tleaq\t{count}(%r15), %r15")
+            if block[-1].strip().startswith("ret"):
+                block.insert(-1, "\tmovq\t%r15, axc_instructions(%rip)")
+        lines.extend(block)
+        block.clear()
+
+    def is_instruction(line):
+        return line.startswith("\t") and not line.lstrip().startswith((".", "#")) and line.strip()
+
+    for line in assembly.splitlines():
+        if LABEL.match(line):
+            flush()
+            lines.append(line)
+            if line.startswith("main:"):
+                lines.append("\tmovq\t$0, %r15")
+            continue
+        if is_instruction(line) and BRANCH.match(line.strip()):
+            block.append(line)
+            flush()
+            continue
+        block.append(line)
+    flush()
+    return "\n".join(lines) + "\n"
+
+
+def counted_instructions(args, program, tmp):
+    """Instructions executed in the generated code, counted by instrumenting the assembly"""
+    if args.machine != "x86_64" or args.os == "macos":
+        return None
+    name = os.path.basename(program)
+    counting = os.path.join(tmp, name + ".count")
+    with open(os.path.join(tmp, name + ".s")) as f:
+        assembly = instrument(f.read())
+    with open(counting + ".s", "w") as f:
+        f.write(assembly)
+    with open(os.path.join(tmp, "counter.c"), "w") as f:
+        f.write(COUNTER)
+    if run([args.cc, "-w", "-o", counting, counting + ".s", os.path.join(tmp, "counter.c")]).returncode != 0:
+        return None
+    result = subprocess.run([counting], stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True,
+                            timeout=args.timeout)
+    lines = result.stderr.split()
+    return int(lines[-1]) if lines and lines[-1].isdigit() else None
+
+
+def instructions(args, program, tmp):
+    """The instruction count, and how it was counted"""
+    count = perf_instructions(program, args.timeout)
+    if count is not None:
+        return count, "perf"
+    count = counted_instructions(args, program, tmp)
+    if count is not None:
+        return count, "assembly"
+    return None, None
+
+
+def measure(args, source, tmp):
+    program, reference, error = build(args, source, tmp)
+    if error:
+        return {"status": error}
+    expected = run([reference], timeout=args.timeout).returncode
+    times = []
+    for _ in range(args.repeat):
+        start = time.perf_counter()
+        try:
+            code = run([program], timeout=args.timeout).returncode
+        except subprocess.TimeoutExpired:
+            return {"status": "timeout"}
+        times.append(time.perf_counter() - start)
+        if code != expected:
+            return {"status": "wrong", "exit": code, "expected": expected}
+    count, counter = instructions(args, program, tmp)
+    return {"status": "ok",
+            "time_ms": round(1000 * statistics.median(times), 3),
+            "instructions": count,
+            "counter": counter}
+
+
+def delta(new, old):
+    if new is None or old is None or old == 0:
+        return ""
+    return f"{100 * (new - old) / old:+.1f}%"
+
+
+def slower(new, old, threshold):
+    return new is not None and old is not None and old > 0 and 100 * (new - old) / old > threshold
+
+
+def report(args, results, baseline):
+    """Print the results against the baseline, returning the programs which regressed"""
+    regressions = []
+    print(f"{'Program':<12} {'Status':<9} {'Time (ms)':>10} {'Base (ms)':>10} {'Change':>8} "
+          f"{'Instructions':>14} {'Change':>8}")
+    for name, result in results.items():
+        old = baseline.get(name, {})
+        time_ms = result.get("time_ms")
+        count = result.get("instructions")
+        # Counts from perf include the C library, so only compare counts made the same way
+        old_count = old.get("instructions") if old.get("counter") == result.get("counter") else None
+        if old.get("status") == "ok" and result["status"] != "ok":
+            regressions.append(f"{name} no longer runs correctly: {result['status']}")
+        if slower(time_ms, old.get("time_ms"), args.time_threshold):
+            regressions.append(f"{name} time {delta(time_ms, old.get('time_ms'))}")
+        if slower(count, old_count, args.instructions_threshold):
+            regressions.append(f"{name} instructions {delta(count, old_count)}")
+        print(f"{name:<12} {result['status']:<9} {time_ms or '':>10} {old.get('time_ms') or '':>10} "
+              f"{delta(time_ms, old.get('time_ms')):>8} {count or '':>14} "
+              f"{delta(count, old_count):>8}")
+    return regressions
+
+
+def main():
+    system = {"Darwin": "macos", "FreeBSD": "freebsd"}.get(platform.system(), "linux")
+    machine = {"arm64": "arm64", "aarch64": "arm64"}.get(platform.machine(), "x86_64")
+
+    app = argparse.ArgumentParser(description="Run the runtime benchmarks of code generated by axc")
+    app.add_argument('--axc', help='path to axc_comp.', default="axc_comp")
+    app.add_argument('--cc', help='C compiler used to assemble, link and for the reference.', default="cc")
+    app.add_argument('--flags', help='extra flags for axc, e.g. -O2.', default="")
+    app.add_argument('--os', help='operating system.', default=system)
+    app.add_argument('-m', '--machine', help='machine architecture.', default=machine)
+    app.add_argument('--repeat', help='number of runs of each program.', type=int, default=5)
+    app.add_argument('--timeout', help='seconds before a run is stopped.', type=int, default=60)
+    app.add_argument('--filter', help='only run programs with this in the name.', default="")
+    app.add_argument('--time-threshold', help='percentage slower in time which is a regression.', type=float,
+                     default=20)
+    app.add_argument('--instructions-threshold', help='percentage more instructions which is a regression.',
+                     type=float, default=2)
+    app.add_argument('--baseline', help='baseline results.', default=os.path.join(CORPUS, "baseline.json"))
+    app.add_argument('--update-baseline', help='save the results as the baseline.', action='store_true')
+    args = app.parse_args()
+
+    baseline = {}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f).get("programs", {})
+
+    results = {}
+    with tempfile.TemporaryDirectory() as tmp:
+        for source in sorted(glob.glob(os.path.join(CORPUS, "*.c"))):
+            name = os.path.splitext(os.path.basename(source))[0]
+            if args.filter in name:
+                results[name] = measure(args, source, tmp)
+
+    regressions = report(args, results, baseline)
+
+    if args.update_baseline:
+        with open(args.baseline, "w") as f:
+            json.dump({"machine": f"{platform.system()} {platform.machine()}", "flags": args.flags,
+                       "programs": dict(sorted({**baseline, **results}.items()))}, f, indent=2)
+            f.write("\n")
+        print(f"Baseline saved to {args.baseline}")
+    elif regressions:
+        print(f"{len(regressions)} regression(s):")
+        for regression in regressions:
+            print(f"  {regression}")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
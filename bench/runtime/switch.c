@@ -0,0 +1,36 @@
+// Switch dispatch: a small stack-free interpreter driven by a pseudo-random program.
+
+int main(void) {
+    int acc = 0;
+    int x = 1;
+    int seed = 12345;
+    for (int i = 0; i < 5000000; i = i + 1) {
+        seed = (seed * 1103 + 12345) & 32767;
+        switch (seed & 7) {
+        case 0:
+            acc = acc + x;
+            break;
+        case 1:
+            acc = acc - x;
+            break;
+        case 2:
+            x = x + 1;
+            break;
+        case 3:
+            x = x ^ acc;
+            break;
+        case 4:
+            acc = acc << 1;
+            break;
+        case 5:
+            acc = acc >> 1;
+            break;
+        case 6:
+            x = x & 1023;
+            break;
+        default:
+            acc = acc | 1;
+        }
+    }
+    return (acc + x) & 255;
+}
@@ -0,0 +1,316 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+#include "assemblyGen.h"
+#include "compilationContext.h"
+#include "filterPseudo.h"
+#include "fixInstructX86.h"
+#include "keywords.h"
+#include "lexer.h"
+#include "option.h"
+#include "parser.h"
+#include "scan.h"
+#include "semanticAnalyser.h"
+#include "symbolTable.h"
+#include "tacGen.h"
+
+// A program of size functions, each with a mix of expressions, branches and loops.
+std::string make_program( const int64_t size ) {
+    std::string buf = "int counter = 0;\n\n";
+    for ( int64_t f = 0; f < size; ++f ) {
+        buf += std::format( "int function_{}(int a, int b) {{\n", f );
+        buf += "    int x = a;\n    int y = b;\n";
+        for ( int s = 0; s < 16; ++s ) {
+            switch ( s % 4 ) {
+            case 0 :
+                buf += std::format( "    x = x + y * {} - (a % {});\n", s + 1, s + 2 );
+                break;
+            case 1 :
+                buf += std::format( "    if (x > {}) y = y + 1; else y = y - x;\n", s );
+                break;
+            case 2 :
+                buf += std::format( "    for (int i = 0; i < {}; i = i + 1) x = x ^ i;\n", s );
+                break;
+            default :
+                buf += "    y = x < y ? x : y << 1;\n";
+            }
+        }
+        buf += "    counter = counter + 1;\n    return x + y;\n}\n\n";
+    }
+    buf += std::format( "int main(void) {{\n    return function_{}(1, 2);\n}}\n", size - 1 );
+    return buf;
+}
+
+// Declarations and statements which are all identifiers and keywords, some of which are nearly keywords.
+std::string make_identifiers( const int64_t size ) {
+    std::string buf;
+    for ( int64_t i = 0; i < size; ++i ) {
+        buf += std::format( "static long counter_{0}; extern int total_{0}; if (index) continue; else break;\n"
+                            "while (done_{0}) do_{0} = double_{0} + returned + intx + longest + in + i;\n",
+                            i );
+    }
+    return buf;
+}
+
+// Expressions which are mostly operators, of one, two and three characters.
+std::string make_operators( const int64_t size ) {
+    std::string buf;
+    for ( int64_t i = 0; i < size; ++i ) {
+        buf += "a<<=b>>=c;a+=b-=c*=d/=e%=f;a&=b|=c^=d;x=a&&b||!c;y=a<=b>=c==d!=e;z=-a+~b*c/d%e<f>g?h:i,j++,k--;\n";
+    }
+    return buf;
+}
+
+// A header which is mostly comments, as system headers are.
+std::string make_header( const int64_t size ) {
+    std::string buf;
+    for ( int64_t i = 0; i < size; ++i ) {
+        buf += std::format( "/*\n * function_{0} adds its arguments, after checking that the sum cannot overflow.\n"
+                            " * Returns 0 if it would.\n */\n"
+                            "extern int function_{0}(int a, int b);       // defined in function_{0}.c\n\n",
+                            i );
+    }
+    return buf;
+}
+
+// Logging is off in the benchmarks.
+Option const quiet { .silent = true };
+
+ast::Program parse( std::string const& source, CompilationContext& context ) {
+    std::istringstream is( source );
+    Lexer              lexer( is );
+    Parser             parser( lexer, context );
+    return parser.parse();
+}
+
+// The front end up to the TAC, for benchmarking the passes after it.
+tac::Program make_tac( std::string const& source, CompilationContext& context ) {
+    auto             program = parse( source, context );
+    SemanticAnalyser analyser( context );
+    analyser.analyse( program );
+    TacGen tac_generator( context );
+    return tac_generator.generate( program );
+}
+
+void BM_Lexer( benchmark::State& state ) {
+    auto const source = make_program( state.range( 0 ) );
+    for ( auto _ : state ) {
+        std::istringstream is( source );
+        Lexer              lexer( is );
+        for ( auto token = lexer.get_token(); token.tok != TokenType::Eof; token = lexer.get_token() ) {
+            benchmark::DoNotOptimize( token );
+        }
+    }
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>( source.size() ) );
+}
+
+void BM_LexerIdentifiers( benchmark::State& state ) {
+    auto const source = make_identifiers( state.range( 0 ) );
+    for ( auto _ : state ) {
+        Lexer lexer( source );
+        for ( auto token = lexer.get_token(); token.tok != TokenType::Eof; token = lexer.get_token() ) {
+            benchmark::DoNotOptimize( token );
+        }
+    }
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>( source.size() ) );
+}
+
+void BM_LexerOperators( benchmark::State& state ) {
+    auto const source = make_operators( state.range( 0 ) );
+    int64_t    tokens = 0;
+    for ( auto _ : state ) {
+        Lexer lexer( source );
+        for ( auto token = lexer.get_token(); token.tok != TokenType::Eof; token = lexer.get_token() ) {
+            benchmark::DoNotOptimize( token );
+            ++tokens;
+        }
+    }
+    state.SetItemsProcessed( tokens ); // tokens per second
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>( source.size() ) );
+}
+
+void BM_LexerComments( benchmark::State& state ) {
+    auto const source = make_header( state.range( 0 ) );
+    for ( auto _ : state ) {
+        Lexer lexer( source );
+        for ( auto token = lexer.get_token(); token.tok != TokenType::Eof; token = lexer.get_token() ) {
+            benchmark::DoNotOptimize( token );
+        }
+    }
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>( source.size() ) );
+}
+
+// Each scanner the processor has, finding the ends of the comments and lines of a header.
+void BM_Scanner( benchmark::State& state ) {
+    auto const scanners = scan::supported();
+    if ( static_cast<size_t>( state.range( 0 ) ) >= scanners.size() ) {
+        state.SkipWithError( "not supported" );
+        return;
+    }
+    auto const& scanner = *scanners[ state.range( 0 ) ];
+    auto const  source = make_header( 1024 );
+    auto const* end = source.data() + source.size();
+    for ( auto _ : state ) {
+        for ( auto const* p = source.data(); p != end; ) {
+            p = scanner.find_comment_end( p, end );
+            p = scanner.find_newline( p, end );
+            p = p == end ? p : scanner.skip_blanks( p + 1, end );
+        }
+    }
+    state.SetLabel( scanner.name );
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>( source.size() ) );
+}
+
+// The words of make_identifiers, for the keyword lookup alone.
+std::vector<std::string> const words { "static", "long", "counter_1", "extern", "int", "total_1", "if",
+                                       "index", "continue", "else", "break", "while", "done_1", "do_1",
+                                       "double_1", "returned", "intx", "longest", "in", "i" };
+
+void BM_Keyword( benchmark::State& state ) {
+    for ( auto _ : state ) {
+        for ( auto const& word : words ) {
+            benchmark::DoNotOptimize( keyword( word ) );
+        }
+    }
+    state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( words.size() ) );
+}
+
+// The std::map the lexer used before keywords.h, for comparison.
+void BM_KeywordMap( benchmark::State& state ) {
+    std::map<std::string, TokenType, std::less<>> map;
+    for ( auto const& [ name, tok ] : keywords::list ) {
+        map.emplace( name, tok );
+    }
+    for ( auto _ : state ) {
+        for ( auto const& word : words ) {
+            auto const found = map.find( std::string_view( word ) );
+            benchmark::DoNotOptimize( found == map.end() ? TokenType::IDENTIFIER : found->second );
+        }
+    }
+    state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( words.size() ) );
+}
+
+void BM_Parser( benchmark::State& state ) {
+    auto const source = make_program( state.range( 0 ) );
+    CompilationContext context( quiet );
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize( parse( source, context ) );
+    }
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>( source.size() ) );
+}
+
+void BM_Semantic( benchmark::State& state ) {
+    auto const source = make_program( state.range( 0 ) );
+    for ( auto _ : state ) {
+        state.PauseTiming();
+        CompilationContext context( quiet );
+        auto               program = parse( source, context );
+        state.ResumeTiming();
+
+        SemanticAnalyser analyser( context );
+        analyser.analyse( program );
+    }
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>( source.size() ) );
+}
+
+void BM_TacGen( benchmark::State& state ) {
+    auto const source = make_program( state.range( 0 ) );
+    for ( auto _ : state ) {
+        state.PauseTiming();
+        CompilationContext context( quiet );
+        auto               program = parse( source, context );
+        SemanticAnalyser   analyser( context );
+        analyser.analyse( program );
+        state.ResumeTiming();
+
+        TacGen tac_generator( context );
+        benchmark::DoNotOptimize( tac_generator.generate( program ) );
+    }
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>( source.size() ) );
+}
+
+void BM_AssemblyGen( benchmark::State& state ) {
+    auto const         source = make_program( state.range( 0 ) );
+    CompilationContext context( quiet );
+    auto const         tac = make_tac( source, context );
+    for ( auto _ : state ) {
+        AssemblyGen assembler( context );
+        benchmark::DoNotOptimize( assembler.generate( tac ) );
+    }
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>( source.size() ) );
+}
+
+void BM_FilterPseudo( benchmark::State& state ) {
+    auto const         source = make_program( state.range( 0 ) );
+    CompilationContext context( quiet );
+    auto const         tac = make_tac( source, context );
+    for ( auto _ : state ) {
+        state.PauseTiming();
+        AssemblyGen assembler( context );
+        auto        assembly = assembler.generate( tac );
+        state.ResumeTiming();
+
+        FilterPseudoX86 filter( context.symbol_table );
+        filter.run( assembly );
+    }
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>( source.size() ) );
+}
+
+void BM_FixInstruct( benchmark::State& state ) {
+    auto const         source = make_program( state.range( 0 ) );
+    CompilationContext context( quiet );
+    auto const         tac = make_tac( source, context );
+    for ( auto _ : state ) {
+        state.PauseTiming();
+        AssemblyGen     assembler( context );
+        auto            assembly = assembler.generate( tac );
+        FilterPseudoX86 filter( context.symbol_table );
+        filter.run( assembly );
+        state.ResumeTiming();
+
+        FixInstructX86 fix;
+        fix.run( assembly );
+    }
+    state.SetBytesProcessed( state.iterations() * static_cast<int64_t>( source.size() ) );
+}
+
+// Program size in functions, each about 600 bytes of source.
+BENCHMARK( BM_Lexer )->RangeMultiplier( 4 )->Range( 1, 1024 );
+BENCHMARK( BM_LexerIdentifiers )->Arg( 4096 );
+BENCHMARK( BM_LexerOperators )->Arg( 4096 );
+BENCHMARK( BM_LexerComments )->Arg( 1024 );
+BENCHMARK( BM_Scanner )->DenseRange( 0, 2 );
+BENCHMARK( BM_Keyword );
+BENCHMARK( BM_KeywordMap );
+BENCHMARK( BM_Parser )->RangeMultiplier( 4 )->Range( 1, 1024 );
+BENCHMARK( BM_Semantic )->RangeMultiplier( 4 )->Range( 1, 1024 );
+BENCHMARK( BM_TacGen )->RangeMultiplier( 4 )->Range( 1, 1024 );
+BENCHMARK( BM_AssemblyGen )->RangeMultiplier( 4 )->Range( 1, 1024 );
+BENCHMARK( BM_FilterPseudo )->RangeMultiplier( 4 )->Range( 1, 1024 );
+BENCHMARK( BM_FixInstruct )->RangeMultiplier( 4 )->Range( 1, 1024 );
+
+int main( int argc, char** argv ) {
+    spdlog::set_level( spdlog::level::off );
+    benchmark::Initialize( &argc, argv );
+    if ( benchmark::ReportUnrecognizedArguments( argc, argv ) ) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,41 @@
+//
+// AXC - C compiler
+//
+// Copyright  © Alex Kowalenko 2025
+//
+
+// Replacement global allocation functions, counting the allocations for --mem-report. The other forms of new and
+// delete call these.
+
+#include <cstdlib>
+#include <new>
+
+#include "memReport.h"
+
+void* operator new( std::size_t size ) {
+    if ( allocation_counting && !allocation_paused ) {
+        allocation_stats.count.fetch_add( 1, std::memory_order_relaxed );
+        allocation_stats.bytes.fetch_add( size, std::memory_order_relaxed );
+    }
+    if ( size == 0 ) {
+        size = 1;
+    }
+    for ( ;; ) {
+        if ( void* p = std::malloc( size ) ) {
+            return p;
+        }
+        auto const handler = std::get_new_handler();
+        if ( handler == nullptr ) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void operator delete( void* p ) noexcept {
+    std::free( p );
+}
+
+void operator delete( void* p, std::size_t ) noexcept {
+    std::free( p );
+}
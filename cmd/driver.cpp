@@ -0,0 +1,303 @@
+//
+// AXC - C compiler
+//
+// Copyright  © Alex Kowalenko 2025
+//
+
+// The axc driver: preprocess and compile a C file, then assemble and link it. The compiler and its preprocessor run in
+// this process and the assembly is piped to the assembler, so no temporary files are written. Run as axc_arm64 it
+// compiles for AArch64. With --watch it stays running, and builds again whenever the source changes.
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+
+#include "compilationContext.h"
+#include "compileCache.h"
+#include "compiler.h"
+#include "includeCache.h"
+#include "mappedFile.h"
+#include "option.h"
+#include "prelude.h"
+#include "process.h"
+#include "watch.h"
+
+struct DriverOption {
+    std::string file;
+    std::string output;              // -o, default the file without its extension, or with .o for -c
+    std::string cc { "clang" };      // assembler and linker
+    bool        object_only { false };
+    bool        watch { false };
+};
+
+int do_args( int argc, char** argv, Option& options, DriverOption& driver ) {
+    argparse::ArgumentParser app { "axc", "0.1" };
+
+    bool const arm64 = std::filesystem::path( argv[ 0 ] ).stem() == "axc_arm64";
+
+    app.add_argument( "-s", "--silent" ).help( "silent operation (no logging)." ).flag().store_into( options.silent );
+    app.add_argument( "-m", "--machine" )
+        .help( "Machine architecture" )
+        .choices( "x86_64", "amd64", "aarch64", "arm64" )
+        .default_value( arm64 ? "arm64" : "x86_64" );
+    app.add_argument( "--os" ).help( "Operating system" ).choices( "linux", "macos", "freebsd" );
+
+    bool  lex { false };
+    bool  parse { false };
+    bool  semantic { false };
+    bool  codegen { false };
+    bool  tac { false };
+    auto& group = app.add_mutually_exclusive_group();
+    group.add_argument( "-l", "--lex" ).help( "run only lexer." ).flag().store_into( lex );
+    group.add_argument( "-p", "--parse" ).help( "run lexer and parser." ).flag().store_into( parse );
+    group.add_argument( "-v", "--validate" ).help( "run the semantic analyser." ).flag().store_into( semantic );
+    group.add_argument( "-t", "--tacky" )
+        .help( "run lexer, parser, semantic, tac generator." )
+        .flag()
+        .store_into( tac );
+    group.add_argument( "-g", "--codegen" )
+        .help( "run lex, parser, semantic tac and codegen, no output." )
+        .flag()
+        .store_into( codegen );
+    group.add_argument( "-c" ).help( "produce an object file only." ).flag().store_into( driver.object_only );
+
+    bool  o1 { false };
+    bool  o2 { false };
+    auto& opt_group = app.add_mutually_exclusive_group();
+    opt_group.add_argument( "-O0" ).help( "no optimisation (default)." ).flag();
+    opt_group.add_argument( "-O1" ).help( "constant folding." ).flag().store_into( o1 );
+    opt_group.add_argument( "-O2" ).help( "constant folding and dead code elimination." ).flag().store_into( o2 );
+
+    app.add_argument( "-I" )
+        .help( "add a directory to search for #include." )
+        .append()
+        .action( [ &options ]( std::string const& path ) { options.include_paths.push_back( path ); } );
+    app.add_argument( "-D" )
+        .help( "define a macro: name or name=value." )
+        .append()
+        .action( [ &options ]( std::string const& definition ) { options.defines.push_back( definition ); } );
+
+    app.add_argument( "--prelude" ).help( "start with the declarations in this prelude, from axc_comp --emit-prelude." );
+    app.add_argument( "--cache-dir" ).help( "keep the assembly of compilations in this directory, and reuse it." );
+    app.add_argument( "--cache-size" )
+        .help( "maximum size of the --cache-dir in MiB." )
+        .default_value( static_cast<int>( default_cache_size >> 20 ) )
+        .scan<'i', int>();
+
+    app.add_argument( "--watch" )
+        .help( "build again each time the file, or a file it includes, changes." )
+        .flag()
+        .store_into( driver.watch );
+
+    app.add_argument( "-o" ).help( "output file." ).store_into( driver.output );
+    app.add_argument( "--cc" ).help( "C compiler used to assemble and link." ).store_into( driver.cc );
+    app.add_argument( "filename" ).help( "File to be compiled" ).store_into( driver.file );
+    try {
+        app.parse_args( argc, argv );
+    } catch ( const std::exception& err ) {
+        std::println( "{}", err.what() );
+        return EXIT_FAILURE;
+    }
+
+    if ( !std::filesystem::exists( driver.file ) ) {
+        std::println( "Input file {} does not exist.", driver.file );
+        return EXIT_FAILURE;
+    }
+    options.input_file = driver.file;
+
+    if ( lex ) {
+        options.stage = Stages::Lex;
+    } else if ( parse ) {
+        options.stage = static_cast<Stages>( Stages::Lex | Stages::Parse );
+    } else if ( semantic ) {
+        options.stage = static_cast<Stages>( Stages::Lex | Stages::Parse | Stages::Semantic );
+    } else if ( tac ) {
+        options.stage = static_cast<Stages>( Stages::Lex | Stages::Parse | Stages::Semantic | Stages::Tac );
+    } else if ( codegen ) {
+        options.stage =
+            static_cast<Stages>( Stages::Lex | Stages::Parse | Stages::Semantic | Stages::Tac | Stages::CodeGen );
+    } else {
+        options.stage = Stages::All;
+    }
+    options.opt_level = o2 ? 2 : o1 ? 1 : 0;
+
+    static Prelude prelude;
+    if ( auto file = app.present( "--prelude" ) ) {
+        try {
+            prelude = read_prelude( *file );
+        } catch ( const std::exception& err ) {
+            std::println( "{}", err.what() );
+            return EXIT_FAILURE;
+        }
+        options.prelude = &prelude;
+    }
+
+    static std::optional<CompileCache> compile_cache;
+    if ( auto directory = app.present( "--cache-dir" ) ) {
+        try {
+            compile_cache.emplace( *directory, static_cast<std::uintmax_t>( app.get<int>( "--cache-size" ) ) << 20 );
+        } catch ( const std::exception& err ) {
+            std::println( "Cannot use compile cache: {}", err.what() );
+            return EXIT_FAILURE;
+        }
+        options.compile_cache = &*compile_cache;
+    }
+
+    auto const machine = app.get( "machine" );
+    options.machine = machine == "aarch64" || machine == "arm64" ? Machine::AArch64 : Machine::X86_64;
+
+    options.system = host_system();
+    if ( auto os = app.present( "--os" ) ) {
+        options.system = *os == "linux" ? System::Linux : *os == "freebsd" ? System::FreeBSD : System::MacOS;
+    }
+
+    if ( driver.output.empty() ) {
+        std::filesystem::path output { driver.file };
+        output.replace_extension( driver.object_only ? ".o" : "" );
+        driver.output = output.string();
+    }
+    return EXIT_SUCCESS;
+}
+
+// Run a step of the build, logging the command.
+int run_step( std::vector<std::string> const& args, std::string_view input = {}, std::string* output = nullptr ) {
+    std::string command;
+    for ( auto const& arg : args ) {
+        command += command.empty() ? arg : " " + arg;
+    }
+    spdlog::info( "{}", command );
+    try {
+        return run_process( args, input, output );
+    } catch ( const std::exception& err ) {
+        std::cerr << err.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
+
+// Compile the file of the context, then assemble and link it.
+int build( CompilationContext& context, DriverOption const& driver ) {
+    auto const&               options = context.option;
+    std::optional<MappedFile> input;
+    try {
+        input.emplace( driver.file );
+    } catch ( const std::exception& err ) {
+        std::cerr << err.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    auto const assembly = compile( context, input->text() );
+    for ( auto const& message : context.diagnostics ) {
+        std::cerr << message << '\n';
+    }
+    if ( context.diagnostics.has_errors() ) {
+        return EXIT_FAILURE;
+    }
+    if ( options.stage != Stages::All ) {
+        std::print( "{}", assembly ); // the tokens for --lex
+        return EXIT_SUCCESS;
+    }
+
+    // Assemble and link
+    std::vector<std::string> command { driver.cc };
+    if ( options.system == System::MacOS ) {
+        command.emplace_back( options.machine == Machine::AArch64 ? "--target=arm64-apple-darwin"
+                                                                  : "--target=x86_64-apple-darwin" );
+    }
+    command.insert( command.end(), { "-x", "assembler", "-" } );
+    if ( driver.object_only ) {
+        command.emplace_back( "-c" );
+    }
+    command.insert( command.end(), { "-o", driver.output } );
+    if ( run_step( command, assembly ) != 0 ) {
+        std::cerr << "Failed to assemble the file and link the executable.\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+FileWatcher* active_watcher { nullptr };
+
+void stop_watching( int ) {
+    active_watcher->stop();
+}
+
+// --watch: build, then build again each time the file or a file it includes changes, until interrupted. The included
+// files are lexed once and the assembly of each function is cached, in a temporary directory if there is no
+// --cache-dir, so a build compiles through to assembly only the functions which have changed.
+int watch( Option options, DriverOption const& driver ) {
+    IncludeCache include_cache;
+    options.include_cache = &include_cache;
+
+    // The source is watched during the first build, and the files it includes from then on.
+    FileWatcher watcher;
+    try {
+        watcher.watch( { driver.file } );
+    } catch ( const std::exception& err ) {
+        std::cerr << err.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    active_watcher = &watcher;
+    std::signal( SIGINT, stop_watching );
+    std::signal( SIGTERM, stop_watching );
+
+    std::filesystem::path       temp_directory;
+    std::optional<CompileCache> compile_cache;
+    if ( !options.compile_cache ) {
+        temp_directory = std::filesystem::temp_directory_path() / std::format( "axc-watch-{}", getpid() );
+        compile_cache.emplace( temp_directory );
+        options.compile_cache = &*compile_cache;
+    }
+
+    int status = EXIT_SUCCESS;
+    do {
+        auto const         start = std::chrono::steady_clock::now();
+        CompilationContext context( options );
+        status = build( context, driver );
+        auto const time =
+            std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - start );
+        std::cerr << std::format( "{} {} in {} ms, waiting for changes.\n",
+                                  status == EXIT_SUCCESS ? "Built" : "Failed to build", driver.output, time.count() );
+
+        std::vector<std::filesystem::path> files { driver.file };
+        files.insert( files.end(), context.included_files.begin(), context.included_files.end() );
+        try {
+            watcher.watch( files );
+        } catch ( const std::exception& err ) {
+            std::cerr << err.what() << '\n';
+            status = EXIT_FAILURE;
+            break;
+        }
+    } while ( watcher.wait() );
+
+    if ( !temp_directory.empty() ) {
+        std::error_code error;
+        std::filesystem::remove_all( temp_directory, error );
+    }
+    return status;
+}
+
+int main( int argc, char** argv ) {
+    Option       options;
+    DriverOption driver;
+    if ( auto status = do_args( argc, argv, options, driver ); status != EXIT_SUCCESS ) {
+        return status;
+    }
+
+    spdlog::set_pattern( "[%H:%M:%S.%f] %^[%l]%$ %v" );
+    spdlog::set_level( options.silent ? spdlog::level::off : spdlog::level::trace );
+    std::signal( SIGPIPE, SIG_IGN ); // a failed step is reported by its exit status
+
+    if ( driver.watch ) {
+        return watch( options, driver );
+    }
+    CompilationContext context( options );
+    return build( context, driver );
+}
@@ -4,21 +4,36 @@
 // Copyright  © Alex Kowalenko 2025
 //
 
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
+#include <iostream>
+#include <optional>
+#include <ranges>
+#include <sstream>
 
 #include <argparse/argparse.hpp>
 #include <spdlog/spdlog.h>
 
-#include "codeGen.h"
-#include "exception.h"
-#include "lexer.h"
+#include "compilationContext.h"
+#include "compileCache.h"
+#include "compileServer.h"
+#include "compiler.h"
+#include "includeCache.h"
+#include "instrument.h"
+#include "jobServer.h"
+#include "mappedFile.h"
+#include "memReport.h"
+#include "nodeCount.h"
 #include "option.h"
-#include "parser.h"
-#include "printerAST.h"
-#include "printerTAC.h"
-#include "semanticAnalyser.h"
-#include "symbolTable.h"
-#include "tacGen.h"
+#include "prelude.h"
+#include "tacPasses.h"
+#include "threadPool.h"
+#include "timeReport.h"
+#include "traceWriter.h"
 
 void setup_logging( Option const& options ) {
     spdlog::set_pattern( "[%H:%M:%S.%f] %^[%l]%$ %v" );
@@ -29,23 +44,49 @@ void setup_logging( Option const& options ) {
     spdlog::set_level( spdlog::level::trace );
 }
 
-void get_os( Option& options ) {
-#if defined( _WIN32 )
-    std::cout << "Windows" << std::endl;
-#elif defined( __APPLE__ ) && defined( __MACH__ )
-    options.system = System::MacOS;
-#elif defined( __linux__ )
-    options.system = System::Linux;
-#elif defined( __FreeBSD__ )
-    options.system = System::FreeBSD;
-#elif defined( __unix__ )
-    options.system = System::Linux;
-#endif
+AsmDump asm_dump_stages( std::string const& stages ) {
+    int dump = AsmDump::AsmNone;
+    for ( auto const stage : std::views::split( stages, ',' ) ) {
+        std::string_view const name( stage.begin(), stage.end() );
+        if ( name == "gen" ) {
+            dump |= AsmDump::AsmGen;
+        } else if ( name == "pseudo" ) {
+            dump |= AsmDump::AsmPseudo;
+        } else if ( name == "fix" ) {
+            dump |= AsmDump::AsmFix;
+        } else if ( name == "final" ) {
+            dump |= AsmDump::AsmFinal;
+        } else if ( name == "all" ) {
+            dump |= AsmDump::AsmAll;
+        } else {
+            throw std::runtime_error( std::format( "Unknown --dump-asm stage: {}", name ) );
+        }
+    }
+    return static_cast<AsmDump>( dump );
 }
 
-int do_args( int argc, char** argv, Option& options ) {
+std::vector<std::string> pass_list( std::string const& passes ) {
+    std::vector<std::string> result;
+    for ( auto const pass : std::views::split( passes, ',' ) ) {
+        std::string const name( pass.begin(), pass.end() );
+        if ( std::ranges::find( tac_pass_names(), name ) == tac_pass_names().end() ) {
+            throw std::runtime_error( std::format( "Unknown pass: {}", name ) );
+        }
+        result.push_back( name );
+    }
+    return result;
+}
+
+// The ways of running other than compiling the files, empty when not used.
+struct RunArgs {
+    std::string serve;        // socket for --serve
+    std::string connect;      // socket for --connect
+    std::string emit_prelude; // prelude file to write
+};
+
+int do_args( int argc, char** argv, Option& options, RunArgs& run ) {
 
-    get_os( options );
+    options.system = host_system();
     argparse::ArgumentParser app { "axc", "0.1" };
 
     app.add_argument( "-s", "--silent" ).help( "silent operation (no logging)." ).flag().store_into( options.silent );
@@ -77,18 +118,123 @@ int do_args( int argc, char** argv, Option& options ) {
         .flag()
         .store_into( codegen );
 
-    app.add_argument( "filename" ).help( "File to be compiled" ).store_into( options.input_file );
+    app.add_argument( "--dump-ast" ).help( "dump the AST after parsing." ).flag().store_into( options.dump_ast );
+    app.add_argument( "--dump-sema" )
+        .help( "dump the AST and symbol table after semantic analysis." )
+        .flag()
+        .store_into( options.dump_sema );
+    app.add_argument( "--dump-tac" ).help( "dump the TAC." ).flag().store_into( options.dump_tac );
+    app.add_argument( "--dump-asm" ).help( "dump the assembly at stages: gen,pseudo,fix,final or all." );
+    auto& dump_group = app.add_mutually_exclusive_group();
+    dump_group.add_argument( "--dump-file" ).help( "write dumps to file (default stdout)." );
+    dump_group.add_argument( "--dump-fd" ).help( "write dumps to an open file descriptor." ).scan<'i', int>();
+
+    bool  o0 { false };
+    bool  o1 { false };
+    bool  o2 { false };
+    auto& opt_group = app.add_mutually_exclusive_group();
+    opt_group.add_argument( "-O0" ).help( "no optimisation (default)." ).flag().store_into( o0 );
+    opt_group.add_argument( "-O1" ).help( "constant folding." ).flag().store_into( o1 );
+    opt_group.add_argument( "-O2" ).help( "constant folding and dead code elimination." ).flag().store_into( o2 );
+    app.add_argument( "--passes" ).help( "run these TAC passes, in order, instead of the -O level: constfold,dce." );
+
+    auto& time_group = app.add_mutually_exclusive_group();
+    time_group.add_argument( "--time-passes", "--time-passes=table" )
+        .help( "report the time taken by each pass, as a table on stderr." )
+        .flag();
+    time_group.add_argument( "--time-passes=json" ).help( "report the time taken by each pass, as JSON." ).flag();
+    app.add_argument( "--trace-out" ).help( "write Chrome trace events of the passes to file." );
+    app.add_argument( "--mem-report" )
+        .help( "report allocations and peak RSS for each pass, and IR nodes by type." )
+        .flag();
+
+    app.add_argument( "-I" )
+        .help( "add a directory to search for #include." )
+        .append()
+        .action( [ &options ]( std::string const& path ) { options.include_paths.push_back( path ); } );
+    app.add_argument( "-D" )
+        .help( "define a macro: name or name=value." )
+        .append()
+        .action( [ &options ]( std::string const& definition ) { options.defines.push_back( definition ); } );
+
+    app.add_argument( "-j", "--jobs" )
+        .help( "compile the files on this many threads, 0 for one per hardware thread. Run by make, the threads after "
+               "the first wait for free job slots. With --serve, the most connections served at once, by default one "
+               "per hardware thread." )
+        .default_value( 1 )
+        .scan<'i', int>()
+        .store_into( options.jobs );
+
+    auto& server_group = app.add_mutually_exclusive_group();
+    server_group.add_argument( "--serve" )
+        .help( "run as a compile server on this Unix socket, compiling the requests of --connect." )
+        .store_into( run.serve );
+    server_group.add_argument( "--connect" )
+        .help( "compile the files on the compile server at this Unix socket." )
+        .store_into( run.connect );
+
+    app.add_argument( "--prelude" ).help( "start with the declarations in this prelude, from --emit-prelude." );
+    app.add_argument( "--cache-dir" ).help( "keep the assembly of compilations in this directory, and reuse it." );
+    app.add_argument( "--cache-size" )
+        .help( "maximum size of the --cache-dir in MiB." )
+        .default_value( static_cast<int>( default_cache_size >> 20 ) )
+        .scan<'i', int>();
+    app.add_argument( "--emit-prelude" )
+        .help( "compile a file of extern declarations to a prelude file, for --prelude." )
+        .store_into( run.emit_prelude );
+
+    app.add_argument( "filename" )
+        .help( "Files to be compiled" )
+        .nargs( argparse::nargs_pattern::any )
+        .store_into( options.input_files );
     try {
         app.parse_args( argc, argv );
+        if ( auto stages = app.present( "--dump-asm" ) ) {
+            options.dump_asm = asm_dump_stages( *stages );
+        }
+        if ( auto passes = app.present( "--passes" ) ) {
+            options.passes = pass_list( *passes );
+        }
     } catch ( const std::exception& err ) {
         std::println( "{}", err.what() );
         return EXIT_FAILURE;
     }
 
-    if ( !std::filesystem::exists( options.input_file ) ) {
-        std::println( "Input file {} does not exist.", options.input_file );
+    if ( auto file = app.present( "--dump-file" ) ) {
+        options.dump_file = std::fopen( file->c_str(), "w" );
+        if ( options.dump_file == nullptr ) {
+            std::println( "Cannot open dump file {}.", *file );
+            return EXIT_FAILURE;
+        }
+    } else if ( auto fd = app.present<int>( "--dump-fd" ) ) {
+        options.dump_file = fdopen( *fd, "w" );
+        if ( options.dump_file == nullptr ) {
+            std::println( "Cannot write dumps to file descriptor {}.", *fd );
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ( options.input_files.empty() && run.serve.empty() ) {
+        std::println( "No input files." );
+        return EXIT_FAILURE;
+    }
+    if ( !run.emit_prelude.empty() && options.input_files.size() != 1 ) {
+        std::println( "A prelude is made from one file." );
+        return EXIT_FAILURE;
+    }
+    for ( auto const& file : options.input_files ) {
+        if ( !std::filesystem::exists( file ) ) {
+            std::println( "Input file {} does not exist.", file );
+            return EXIT_FAILURE;
+        }
+    }
+    if ( options.jobs < 0 ) {
+        std::println( "Number of jobs must be 0 or more." );
         return EXIT_FAILURE;
     }
+    if ( !run.serve.empty() && !app.is_used( "--jobs" ) ) {
+        options.jobs = 0; // a connection holds a thread while it is open, so serve as many as the hardware can
+    }
 
     if ( lex ) {
         options.stage = Stages::Lex;
@@ -105,6 +251,56 @@ int do_args( int argc, char** argv, Option& options ) {
         options.stage = Stages::All;
     }
 
+    options.opt_level = o2 ? 2 : o1 ? 1 : 0;
+
+    // Headers included by several of the files are read once.
+    static IncludeCache include_cache;
+    options.include_cache = &include_cache;
+
+    static Prelude prelude;
+    if ( auto file = app.present( "--prelude" ) ) {
+        try {
+            prelude = read_prelude( *file );
+        } catch ( const std::exception& err ) {
+            std::println( "{}", err.what() );
+            return EXIT_FAILURE;
+        }
+        if ( is_current( prelude ) ) {
+            options.prelude = &prelude;
+        } else {
+            std::println( "Prelude {} is out of date with {}, which is included instead.", *file, prelude.source );
+        }
+    }
+
+    static std::optional<CompileCache> compile_cache;
+    if ( auto directory = app.present( "--cache-dir" ) ) {
+        try {
+            compile_cache.emplace( *directory, static_cast<std::uintmax_t>( app.get<int>( "--cache-size" ) ) << 20 );
+        } catch ( const std::exception& err ) {
+            std::println( "Cannot use compile cache: {}", err.what() );
+            return EXIT_FAILURE;
+        }
+        options.compile_cache = &*compile_cache;
+    }
+
+    static Instrumentation instrument;
+    if ( app.get<bool>( "--time-passes" ) || app.get<bool>( "--time-passes=json" ) ) {
+        auto const format =
+            app.get<bool>( "--time-passes=json" ) ? TimeReport::Format::Json : TimeReport::Format::Table;
+        instrument.add( std::make_unique<TimeReport>( format, stderr ) );
+    }
+    if ( auto file = app.present( "--trace-out" ) ) {
+        instrument.add( std::make_unique<TraceWriter>( *file ) );
+    }
+    if ( app.get<bool>( "--mem-report" ) ) {
+        allocation_counting = true;
+        node_counting = true;
+        instrument.add( std::make_unique<MemReport>( stderr ) );
+    }
+    if ( !instrument.empty() ) {
+        options.instrument = &instrument;
+    }
+
     if ( app.get( "machine" ) == "x86_64" || app.get( "machine" ) == "amd64" ) {
         options.machine = Machine::X86_64;
     } else if ( app.get( "machine" ) == "aarch64" || app.get( "machine" ) == "arm64" ) {
@@ -124,124 +320,221 @@ int do_args( int argc, char** argv, Option& options ) {
     return EXIT_SUCCESS;
 }
 
-Lexer run_lexer( Option const& options ) {
-    spdlog::info( "Run lexer," );
-    std::ifstream file { options.input_file };
-    Lexer         lexer { file };
-    return lexer;
-}
+// Writes the reports of --time-passes, --trace-out and --mem-report when it goes out of scope, so that they are
+// written however main returns, for failed compilations too.
+class Reports {
+  public:
+    explicit Reports( Option const& options ) : options( options ) {};
+    Reports( Reports const& ) = delete;
+    Reports& operator=( Reports const& ) = delete;
+    ~Reports() {
+        if ( options.instrument ) {
+            options.instrument->report();
+        }
+    }
 
-ast::Program run_parser( Lexer& lexer ) {
-    spdlog::info( "Run parser," );
-    Parser parser { lexer };
-    auto   program = parser.parse();
-
-    PrinterAST printer;
-    auto       output = printer.print( program );
-    std::println( "Parsing Output:" );
-    std::println( "--------------" );
-    std::println( "{:s}", output );
-    return program;
-}
+  private:
+    Option const& options;
+};
 
-void run_sematic( ast::Program program, SymbolTable& symbol_table ) {
-    spdlog::info( "Run semantic anylser," );
-    SemanticAnalyser analyser;
-    analyser.analyse( program, symbol_table );
+// Compile the file of the context, writing the assembly next to it with the extension .s.
+void compile_file( CompilationContext& context, std::string& output ) {
+    auto const&               options = context.option;
+    std::optional<MappedFile> source;
+    try {
+        source.emplace( options.input_file );
+    } catch ( const std::exception& err ) {
+        context.diagnostics.error( err.what() );
+        return;
+    }
+    auto text = compile( context, source->text() );
+    if ( ( options.stage & Stages::Parse ) == 0 ) {
+        output = std::move( text );
+        return;
+    }
+    if ( ( options.stage & Stages::File ) == 0 || context.diagnostics.has_errors() ) {
+        return;
+    }
 
-    PrinterAST printer;
-    auto       output = printer.print( program );
-    std::println( "Semantic Output:" );
-    std::println( "----------------" );
-    std::println( "{:s}", output );
+    Region                region( options.instrument, "write" );
+    std::filesystem::path file_name { options.input_file };
+    file_name.replace_extension( ".s" );
+    std::ofstream file { file_name };
+    file.write( text.data(), static_cast<std::streamsize>( text.size() ) );
+    if ( !file ) {
+        context.diagnostics.error( std::format( "Code Generation: Cannot write file {}", file_name.string() ) );
+    }
 }
 
-tac::Program run_tac( ast::Program program, SymbolTable& table ) {
-    spdlog::info( "Run TAC generator," );
-    TacGen tac_generator( table );
-    auto   tac = tac_generator.generate( program );
-
-    PrinterTAC tac_printer;
-    auto       output = tac_printer.print( tac );
-    std::println( "TAC Output:" );
-    std::println( "----------" );
-    std::println( "{:s}", output );
-    return tac;
+// The result of compiling one file. The messages are held until all the files are compiled, so that the output of
+// each file is kept together and in the order of the files on the command line.
+struct Compilation {
+    std::unique_ptr<CompilationContext> context;
+    std::string                         output; // tokens from --lex
+    std::string                         dumps;  // IR dumps, when compiling several files
+};
+
+// Compile one of several files, with its dumps written to memory.
+void compile_batch_file( Option options, std::string const& file, Compilation& result ) {
+    options.input_file = file;
+    char*  buffer = nullptr;
+    size_t size = 0;
+    options.dump_file = open_memstream( &buffer, &size );
+    result.context = std::make_unique<CompilationContext>( options );
+    compile_file( *result.context, result.output );
+    std::fclose( options.dump_file );
+    result.dumps.assign( buffer, size );
+    std::free( buffer );
 }
 
-int main( int argc, char** argv ) {
-    Option options;
-
-    if ( auto status = do_args( argc, argv, options ); status != EXIT_SUCCESS ) {
-        std::exit( status );
+// --emit-prelude: compile the file to a prelude.
+int run_emit_prelude( std::string const& prelude_file, Option options ) {
+    options.input_file = options.input_files.front();
+    CompilationContext context( options );
+    std::ifstream      source { options.input_file };
+    if ( !source ) {
+        std::cerr << std::format( "Cannot read {}", options.input_file ) << '\n';
+        return EXIT_FAILURE;
+    }
+    auto prelude = compile_prelude( context, source );
+    for ( auto const& message : context.diagnostics ) {
+        std::cerr << message << '\n';
+    }
+    if ( !prelude ) {
+        return EXIT_FAILURE;
+    }
+    std::ofstream output { prelude_file };
+    write_prelude( output, *prelude );
+    if ( !output ) {
+        std::cerr << std::format( "Cannot write prelude {}", prelude_file ) << '\n';
+        return EXIT_FAILURE;
     }
+    return EXIT_SUCCESS;
+}
 
-    setup_logging( options );
-    spdlog::info( "AXC compiler 👾" );
+CompileServer* active_server { nullptr };
+
+void stop_server( int ) {
+    active_server->stop();
+}
 
+// --serve: compile requests until interrupted.
+int run_server( std::string const& socket_path, Option const& options ) {
     try {
-        // Run Lexer
-        Lexer lexer = run_lexer( options );
+        CompileServer compile_server( socket_path, options );
+        active_server = &compile_server;
+        std::signal( SIGINT, stop_server );
+        std::signal( SIGTERM, stop_server );
+        compile_server.run();
+    } catch ( const std::exception& err ) {
+        std::cerr << err.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
 
-        if ( ( options.stage & Stages::Parse ) == 0 ) {
-            for ( Token token = lexer.get_token(); token.tok != TokenType::Eof; token = lexer.get_token() ) {
-                std::println( "{} {} ", token.location, ( token ) );
-            }
-            std::println( "" );
-            return EXIT_SUCCESS;
+// --connect: compile each file on the server, writing the assembly next to it.
+int run_client( std::string const& socket_path, Option const& options ) {
+    int status = EXIT_SUCCESS;
+    for ( auto const& file : options.input_files ) {
+        std::ifstream input { file };
+        if ( !input ) {
+            std::cerr << std::format( "Cannot read {}", file ) << '\n';
+            status = EXIT_FAILURE;
+            continue;
         }
-
-        // Run Parser
-        auto program = run_parser( lexer );
-
-        if ( ( options.stage & Stages::Semantic ) == 0 ) {
-            return EXIT_SUCCESS;
+        std::ostringstream source;
+        source << input.rdbuf();
+
+        CompileRequest request { .file = file,
+                                 .machine = options.machine,
+                                 .system = options.system,
+                                 .opt_level = options.opt_level,
+                                 .passes = options.passes,
+                                 .include_paths = options.include_paths,
+                                 .defines = options.defines,
+                                 .source = std::move( source ).str() };
+        CompileResult  result;
+        try {
+            result = compile_remote( socket_path, request );
+        } catch ( const std::exception& err ) {
+            std::cerr << err.what() << '\n';
+            return EXIT_FAILURE;
         }
 
-        SymbolTable symbol_table;
-        run_sematic( program, symbol_table );
-
-        if ( ( options.stage & Stages::Tac ) == 0 ) {
-            return EXIT_SUCCESS;
+        for ( auto const& message : result.diagnostics ) {
+            if ( options.input_files.size() > 1 ) {
+                std::cerr << file << ": ";
+            }
+            std::cerr << message << '\n';
+        }
+        if ( !result.success ) {
+            status = EXIT_FAILURE;
+            continue;
+        }
+        std::filesystem::path file_name { file };
+        file_name.replace_extension( ".s" );
+        std::ofstream output { file_name };
+        output << result.assembly;
+        if ( !output ) {
+            std::cerr << std::format( "Cannot write file {}", file_name.string() ) << '\n';
+            status = EXIT_FAILURE;
         }
+    }
+    return status;
+}
 
-        // Run TAC Generator
-        auto tac = run_tac( program, symbol_table );
+int main( int argc, char** argv ) {
+    Option     options;
+    RunArgs    run_args;
 
-        if ( ( options.stage & Stages::CodeGen ) == 0 ) {
-            return EXIT_SUCCESS;
-        }
+    if ( auto status = do_args( argc, argv, options, run_args ); status != EXIT_SUCCESS ) {
+        std::exit( status );
+    }
 
-        // Run Code Gen
-        auto codeGenerator = make_CodeGen( options, symbol_table );
-        if ( !codeGenerator ) {
-            throw CodeException( Location {}, "Cannot create code generator for machine: {}",
-                                 to_string( options.machine ) );
-        }
+    setup_logging( options );
+    spdlog::info( "AXC compiler 👾" );
+    Reports const reports( options );
 
-        auto assembly = codeGenerator->run_codegen( tac );
+    if ( !run_args.serve.empty() ) {
+        return run_server( run_args.serve, options );
+    }
+    if ( !run_args.connect.empty() ) {
+        return run_client( run_args.connect, options );
+    }
+    if ( !run_args.emit_prelude.empty() ) {
+        return run_emit_prelude( run_args.emit_prelude, options );
+    }
 
-        if ( ( options.stage & Stages::File ) == 0 ) {
-            return EXIT_SUCCESS;
+    std::vector<Compilation> results( options.input_files.size() );
+    if ( results.size() == 1 ) {
+        options.input_file = options.input_files.front();
+        results.front().context = std::make_unique<CompilationContext>( options );
+        compile_file( *results.front().context, results.front().output );
+    } else {
+        // Run by make -jN, the threads share the build's job slots.
+        auto const   jobserver = JobServer::from_environment();
+        size_t const jobs = options.jobs == 0 ? std::thread::hardware_concurrency() : options.jobs;
+        ThreadPool   pool( std::min( jobs, results.size() ), jobserver.get(), "compile" );
+        for ( size_t i = 0; i < results.size(); ++i ) {
+            pool.submit( [ &, i ] { compile_batch_file( options, options.input_files[ i ], results[ i ] ); } );
         }
+        pool.wait();
+    }
 
-        codeGenerator->generate_output_file( assembly );
-
-    } catch ( const LexicalException& e ) {
-        std::cerr << std::format( "Lexical error: {}", e.get_message() ) << '\n';
-        return EXIT_FAILURE;
-    } catch ( const ParseException& e ) {
-        std::cerr << std::format( "Parse error: {}", e.get_message() ) << '\n';
-        return EXIT_FAILURE;
-    } catch ( const SemanticException& e ) {
-        std::cerr << std::format( "Semantic error: {}", e.get_message() ) << '\n';
-        return EXIT_FAILURE;
-    } catch ( const CodeException& e ) {
-        std::cerr << std::format( "Code Generation: {}", e.get_message() ) << '\n';
-        return EXIT_FAILURE;
-    } catch ( const std::exception& err ) {
-        std::cerr << std::format( "Exception: {}", err.what() ) << '\n';
-        return EXIT_FAILURE;
+    int status = EXIT_SUCCESS;
+    for ( auto const& result : results ) {
+        std::print( "{}", result.output );
+        std::print( options.dump_file, "{}", result.dumps );
+        for ( auto const& message : result.context->diagnostics ) {
+            if ( results.size() > 1 ) {
+                std::cerr << result.context->option.input_file << ": ";
+            }
+            std::cerr << message << '\n';
+        }
+        if ( result.context->diagnostics.has_errors() ) {
+            status = EXIT_FAILURE;
+        }
     }
-    return EXIT_SUCCESS;
+    return status;
 }
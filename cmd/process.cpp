@@ -0,0 +1,124 @@
+//
+// AXC - C compiler
+//
+// Copyright  © Alex Kowalenko 2025
+//
+
+#include "process.h"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace {
+
+void make_pipe( std::array<int, 2>& fds ) {
+    if ( ::pipe( fds.data() ) < 0 ) {
+        throw std::runtime_error( std::format( "Cannot create pipe: {}", std::strerror( errno ) ) );
+    }
+    for ( int const fd : fds ) {
+        ::fcntl( fd, F_SETFD, FD_CLOEXEC );
+    }
+}
+
+void close_fd( int& fd ) {
+    if ( fd >= 0 ) {
+        ::close( fd );
+        fd = -1;
+    }
+}
+
+// Write the input and read the output at the same time, so that neither side blocks on a full pipe.
+void pump( int in, std::string_view input, int out, std::string* output ) {
+    if ( in >= 0 ) {
+        ::fcntl( in, F_SETFL, ::fcntl( in, F_GETFL ) | O_NONBLOCK );
+    }
+    std::array<char, 64 * 1024> buffer;
+    while ( in >= 0 || out >= 0 ) {
+        std::array<pollfd, 2> fds { pollfd { .fd = in, .events = POLLOUT, .revents = 0 },
+                                    pollfd { .fd = out, .events = POLLIN, .revents = 0 } };
+        if ( ::poll( fds.data(), fds.size(), -1 ) < 0 ) {
+            if ( errno == EINTR ) {
+                continue;
+            }
+            break;
+        }
+        if ( fds[ 0 ].revents != 0 ) {
+            auto const n = ::write( in, input.data(), input.size() );
+            if ( n > 0 ) {
+                input.remove_prefix( n );
+            }
+            if ( input.empty() || ( n < 0 && errno != EAGAIN && errno != EINTR ) ) {
+                close_fd( in ); // finished, or the program stopped reading
+            }
+        }
+        if ( fds[ 1 ].revents != 0 ) {
+            auto const n = ::read( out, buffer.data(), buffer.size() );
+            if ( n > 0 ) {
+                output->append( buffer.data(), n );
+            } else if ( n == 0 || errno != EINTR ) {
+                close_fd( out );
+            }
+        }
+    }
+    close_fd( in );
+    close_fd( out );
+}
+
+} // namespace
+
+int run_process( std::vector<std::string> const& args, std::string_view input, std::string* output ) {
+    std::array<int, 2> in { -1, -1 };
+    std::array<int, 2> out { -1, -1 };
+    make_pipe( in );
+    if ( output != nullptr ) {
+        make_pipe( out );
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init( &actions );
+    posix_spawn_file_actions_adddup2( &actions, in[ 0 ], STDIN_FILENO );
+    if ( output != nullptr ) {
+        posix_spawn_file_actions_adddup2( &actions, out[ 1 ], STDOUT_FILENO );
+    }
+
+    std::vector<char*> argv;
+    for ( auto const& arg : args ) {
+        argv.push_back( const_cast<char*>( arg.c_str() ) );
+    }
+    argv.push_back( nullptr );
+
+    pid_t      pid;
+    auto const error = posix_spawnp( &pid, argv[ 0 ], &actions, nullptr, argv.data(), environ );
+    posix_spawn_file_actions_destroy( &actions );
+    close_fd( in[ 0 ] );
+    close_fd( out[ 1 ] );
+    if ( error != 0 ) {
+        close_fd( in[ 1 ] );
+        close_fd( out[ 0 ] );
+        throw std::runtime_error( std::format( "Cannot run {}: {}", args.front(), std::strerror( error ) ) );
+    }
+
+    pump( in[ 1 ], input, out[ 0 ], output );
+
+    int status = 0;
+    while ( ::waitpid( pid, &status, 0 ) < 0 ) {
+        if ( errno != EINTR ) {
+            throw std::runtime_error( std::format( "Cannot wait for {}: {}", args.front(), std::strerror( errno ) ) );
+        }
+    }
+    if ( WIFSIGNALED( status ) ) {
+        return 128 + WTERMSIG( status );
+    }
+    return WEXITSTATUS( status );
+}
@@ -0,0 +1,16 @@
+//
+// AXC - C compiler
+//
+// Copyright  © Alex Kowalenko 2025
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Run a program, found on the PATH, without a shell. The input is written to its standard input and, if output is not
+// null, its standard output is read into output. Returns the exit status, or 128 plus the signal that killed it.
+// Throws if the program cannot be started.
+int run_process( std::vector<std::string> const& args, std::string_view input = {}, std::string* output = nullptr );
@@ -0,0 +1,146 @@
+//
+// AXC - C compiler
+//
+// Copyright  © Alex Kowalenko 2025
+//
+
+#include "watch.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <poll.h>
+#include <unistd.h>
+#if defined( __linux__ )
+#include <sys/inotify.h>
+#endif
+
+namespace {
+
+constexpr auto poll_interval = std::chrono::milliseconds( 100 );
+
+// Editors write a file in several steps, which are waited for to compile once.
+constexpr auto settle_time = std::chrono::milliseconds( 50 );
+
+std::filesystem::file_time_type modified( std::filesystem::path const& file ) {
+    std::error_code error;
+    auto const      time = std::filesystem::last_write_time( file, error );
+    return error ? std::filesystem::file_time_type::min() : time;
+}
+
+} // namespace
+
+FileWatcher::~FileWatcher() {
+    if ( fd >= 0 ) {
+        ::close( fd );
+    }
+}
+
+void FileWatcher::watch( std::vector<std::filesystem::path> const& watched ) {
+    std::set<std::filesystem::path> next;
+    for ( auto const& file : watched ) {
+        next.insert( std::filesystem::absolute( file ).lexically_normal() );
+    }
+    for ( auto const& file : next ) {
+        if ( !files.contains( file ) && modified( file ) > since ) {
+            pending = true;
+        }
+    }
+    files = std::move( next );
+#if defined( __linux__ )
+    if ( fd < 0 ) {
+        fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+        if ( fd < 0 ) {
+            throw std::runtime_error( std::format( "inotify: {}", std::strerror( errno ) ) );
+        }
+    }
+    std::set<std::filesystem::path> needed;
+    for ( auto const& file : files ) {
+        needed.insert( file.parent_path() );
+    }
+    for ( auto it = watches.begin(); it != watches.end(); ) {
+        if ( needed.contains( it->first ) ) {
+            ++it;
+            continue;
+        }
+        inotify_rm_watch( fd, it->second );
+        directories.erase( it->second );
+        it = watches.erase( it );
+    }
+    for ( auto const& directory : needed ) {
+        if ( watches.contains( directory ) ) {
+            continue;
+        }
+        int const wd = inotify_add_watch( fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO );
+        if ( wd < 0 ) {
+            throw std::runtime_error( std::format( "Cannot watch {}: {}", directory.string(), std::strerror( errno ) ) );
+        }
+        directories[ wd ] = directory;
+        watches[ directory ] = wd;
+    }
+#else
+    std::erase_if( times, [ this ]( auto const& entry ) { return !files.contains( entry.first ); } );
+    for ( auto const& file : files ) {
+        // The files already watched keep their times from before the build, so changes during it are seen.
+        times.try_emplace( file, modified( file ) );
+    }
+#endif
+}
+
+bool FileWatcher::wait() {
+    while ( !stopping ) {
+        if ( std::exchange( pending, false ) || changed() ) {
+            // Let the writes settle, and drop the changes they make.
+            std::this_thread::sleep_for( settle_time );
+            changed();
+            since = std::filesystem::file_time_type::clock::now();
+            return !stopping;
+        }
+    }
+    return false;
+}
+
+#if defined( __linux__ )
+
+// Wait up to the poll interval for an event on one of the files.
+bool FileWatcher::changed() {
+    pollfd ready { .fd = fd, .events = POLLIN, .revents = 0 };
+    if ( ::poll( &ready, 1, static_cast<int>( poll_interval.count() ) ) <= 0 ) {
+        return false;
+    }
+    bool found = false;
+    alignas( inotify_event ) char buffer[ 4096 ];
+    for ( ssize_t size; ( size = ::read( fd, buffer, sizeof( buffer ) ) ) > 0; ) {
+        for ( char* next = buffer; next < buffer + size; ) {
+            auto const* event = reinterpret_cast<inotify_event const*>( next );
+            next += sizeof( inotify_event ) + event->len;
+            if ( event->len > 0 && directories.contains( event->wd ) &&
+                 files.contains( directories[ event->wd ] / event->name ) ) {
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+#else
+
+// Wait the poll interval, and look for files with new modification times.
+bool FileWatcher::changed() {
+    std::this_thread::sleep_for( poll_interval );
+    bool found = false;
+    for ( auto& [ file, time ] : times ) {
+        if ( auto const now = modified( file ); now != time ) {
+            time = now;
+            found = true;
+        }
+    }
+    return found;
+}
+
+#endif
@@ -0,0 +1,53 @@
+//
+// AXC - C compiler
+//
+// Copyright  © Alex Kowalenko 2025
+//
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <vector>
+
+// Waits for files to change. Uses inotify on Linux, watching the directories of the files so that a file replaced by
+// an editor is seen, and elsewhere polls the modification times of the files. The files stay watched between waits, so
+// a change made while the caller is building is seen by the next wait.
+class FileWatcher {
+  public:
+    FileWatcher() = default;
+    ~FileWatcher();
+
+    FileWatcher( FileWatcher const& ) = delete;
+    FileWatcher& operator=( FileWatcher const& ) = delete;
+
+    // Watch these files instead of those watched before, adding and removing only the watches which differ. A file
+    // which is new to the watcher and was changed since the last wait returned counts as a change. Throws if they
+    // can't be watched.
+    void watch( std::vector<std::filesystem::path> const& files );
+
+    // Block until one of the files is written or replaced, or return at once for a change since the last wait.
+    // Returns false if stopped.
+    bool wait();
+
+    // Stop waiting. Can be called from a signal handler.
+    void stop() { stopping = true; }
+
+  private:
+    bool changed();
+
+    std::set<std::filesystem::path> files;
+    std::atomic<bool>               stopping { false };
+    std::filesystem::file_time_type since { std::filesystem::file_time_type::clock::now() }; // the last wait returned
+    bool                            pending { false }; // a new file changed since then
+
+    // inotify
+    int                                  fd { -1 };
+    std::map<int, std::filesystem::path> directories; // of each watch
+    std::map<std::filesystem::path, int> watches;     // of each directory
+
+    // polling
+    std::map<std::filesystem::path, std::filesystem::file_time_type> times;
+};
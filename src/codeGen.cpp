@@ -9,29 +9,35 @@
 //
 
 #include "codeGen.h"
+#include "dump.h"
 #include "exception.h"
 #include "machine/arm64/arm64CodeGen.h"
 #include "machine/x86_64/x86_64CodeGen.h"
 
-std::unique_ptr<CodeGenerator> make_CodeGen( Option const& option, SymbolTable& symbol_table ) {
-    switch ( option.machine ) {
+std::unique_ptr<CodeGenerator> make_CodeGen( CompilationContext& context ) {
+    switch ( context.option.machine ) {
     case Machine::X86_64 :
-        return std::make_unique<X86_64CodeGen>( option, symbol_table );
+        return std::make_unique<X86_64CodeGen>( context );
     case Machine::AArch64 :
-        return std::make_unique<Arm64CodeGen>( option, symbol_table );
+        return std::make_unique<Arm64CodeGen>( context );
     default :
         throw CodeException( "Unsupported machine" );
     }
 }
 
-void CodeGenerator::make_output_file_name() {
-    output = option.input_file;
-    output.replace_extension( ".s" );
+std::string const& CodeGenerator::generate_assembly( const CodeGenBase assembly ) {
+    context.logger->info( "Generate assembly for {}.", to_string( option.machine ) );
+    text.clear();
+    generate( assembly );
+    if ( option.dump_asm & AsmDump::AsmFinal ) {
+        dump( option, std::format( "{} Assembly", to_string( option.machine ) ), text );
+    }
+    return text;
 }
 
 void CodeGenerator::add_line( const std::string& line ) {
-    file << line << '\n';
-    text << line << '\n';
+    text += line;
+    text += '\n';
 }
 
 void CodeGenerator::add_line( std::string const& instruct, std::string const& operands, int line_number ) {
@@ -67,7 +73,3 @@ void CodeGenerator::add_line( std::string const& instruct, std::string const& op
     }
     add_line( line );
 }
-
-std::string CodeGenerator::get_output() const {
-    return text.str();
-}
\ No newline at end of file
@@ -10,14 +10,12 @@
 
 #pragma once
 
+#include "compilationContext.h"
 #include "option.h"
 #include "symbolTable.h"
 #include "tac/includes.h"
 
-#include <filesystem>
-#include <fstream>
 #include <memory>
-#include <sstream>
 #include <string>
 
 class CodeGenBase_ {
@@ -30,20 +28,20 @@ using CodeGenBase = std::shared_ptr<CodeGenBase_>;
 
 class CodeGenerator {
   public:
-    CodeGenerator( Option const& option, SymbolTable& symbol_table )
-        : option( option ), symbol_table( symbol_table ) {};
+    explicit CodeGenerator( CompilationContext& context )
+        : context( context ), option( context.option ), symbol_table( context.symbol_table ) {};
     virtual ~CodeGenerator() = default;
 
     virtual CodeGenBase run_codegen( tac::Program tac ) = 0;
-    virtual void        generate_output_file( CodeGenBase assembly ) = 0;
 
-    std::string get_output() const;
+    // The assembly text of the program from run_codegen.
+    std::string const& generate_assembly( CodeGenBase assembly );
+
+    [[nodiscard]] std::string const& get_output() const { return text; }
 
   protected:
     virtual void generate( CodeGenBase program ) = 0;
 
-    void make_output_file_name();
-
     void add_line( std::string const& line );
     void add_line( std::string const& instruct, std::string const& operands, int line_number = 0 );
     void add_line( std::string const& instruct, std::string const& operand1, std::string const& operand2,
@@ -51,13 +49,12 @@ class CodeGenerator {
     void add_line( std::string const& instruct, std::string const& operand1, std::string const& operand2,
                    std::string const& operand3, int line_number = 0 );
 
+    CompilationContext&   context;
     Option const&         option;
     SymbolTable&          symbol_table;
-    std::filesystem::path output;
-    std::fstream          file;
-    std::stringstream     text;
+    std::string           text;
 
     std::string comment_prefix = "# ";
 };
 
-std::unique_ptr<CodeGenerator> make_CodeGen( Option const& option, SymbolTable& symbol_table );
\ No newline at end of file
+std::unique_ptr<CodeGenerator> make_CodeGen( CompilationContext& context );
\ No newline at end of file
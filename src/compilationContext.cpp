@@ -0,0 +1,45 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "compilationContext.h"
+
+#include <format>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include "prelude.h"
+
+std::string NameGenerator::temp_name( std::string_view basename ) {
+    return std::format( "{}.{}", basename, temp_counter++ );
+}
+
+std::string NameGenerator::label( std::string_view name ) {
+    return std::format( "{:s}.{:d}", name, label_counter++ );
+}
+
+std::shared_ptr<spdlog::logger> make_logger( Option const& option ) {
+    static auto const sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+
+    auto logger = std::make_shared<spdlog::logger>( option.input_file, sink );
+    logger->set_pattern( "[%H:%M:%S.%f] %^[%l]%$ %v" );
+    logger->set_level( option.silent ? spdlog::level::off : spdlog::level::trace );
+    return logger;
+}
+
+CompilationContext::CompilationContext( Option option ) : option( std::move( option ) ) {
+    logger = make_logger( this->option );
+    if ( this->option.prelude && !is_current( *this->option.prelude ) ) {
+        logger->warn( "Prelude of {} is out of date, so it is included", this->option.prelude->source );
+        this->option.prelude = nullptr;
+    }
+    if ( this->option.prelude ) {
+        symbol_table.copy( this->option.prelude->symbols );
+    }
+}
@@ -0,0 +1,67 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "option.h"
+#include "symbolTable.h"
+
+// Generates the names which have to be unique in a compilation: the renamed variables, temporaries and labels.
+class NameGenerator {
+  public:
+    std::string temp_name( std::string_view basename = "temp" );
+    std::string label( std::string_view name );
+
+  private:
+    std::int32_t temp_counter { 0 };
+    size_t       label_counter { 0 };
+};
+
+// The errors found in a compilation, printed by the driver once it is finished.
+class Diagnostics {
+  public:
+    void error( std::string message ) { messages.push_back( std::move( message ) ); }
+
+    [[nodiscard]] bool has_errors() const { return !messages.empty(); }
+    [[nodiscard]] auto begin() const { return messages.cbegin(); }
+    [[nodiscard]] auto end() const { return messages.cend(); }
+
+  private:
+    std::vector<std::string> messages;
+};
+
+// A logger for a compilation, at the level set by the options. The loggers share the one console sink.
+std::shared_ptr<spdlog::logger> make_logger( Option const& option );
+
+// The state of compiling one translation unit. All that the stages and passes change is held here rather than in
+// globals, so that several compilations can run at the same time in one process.
+class CompilationContext {
+  public:
+    explicit CompilationContext( Option option );
+    ~CompilationContext() = default;
+
+    CompilationContext( CompilationContext const& ) = delete;
+    CompilationContext& operator=( CompilationContext const& ) = delete;
+
+    Option                          option;
+    SymbolTable                     symbol_table;
+    NameGenerator                   names;
+    Diagnostics                     diagnostics;
+    std::vector<std::string>        included_files; // read by the preprocessor for #include
+    std::shared_ptr<spdlog::logger> logger;
+};
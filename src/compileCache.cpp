@@ -0,0 +1,188 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "compileCache.h"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include "hash.h"
+#include "prelude.h"
+
+std::string compile_key( std::vector<Token> const& tokens, Option const& option ) {
+    Hash hash;
+    hash.add( compiler_version );
+    hash.add( option.input_file ); // named in the assembly
+    hash.add( option.machine ).add( option.system ).add( option.stage ).add( option.opt_level );
+    for ( auto const& pass : option.passes ) {
+        hash.add( pass );
+    }
+    if ( option.prelude ) {
+        hash.add( option.prelude->source );
+        for ( auto const& [ name, symbol ] : option.prelude->symbols ) {
+            hash.add( name ).add( symbol.type ).add( symbol.storage ).add( symbol.number );
+        }
+    }
+    for ( auto const& token : tokens ) {
+        hash.add( token.tok ).add( token.location.line ).add( token.location.col ).add( token.value );
+    }
+    return hash.hex();
+}
+
+namespace {
+
+// The summary is a fixed width number, so it is rewritten in place.
+constexpr size_t summary_width = 20;
+
+// Open and lock the summary, which is unlocked when it is closed.
+int lock_summary( std::filesystem::path const& summary ) {
+    int const fd = ::open( summary.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644 );
+    if ( fd >= 0 && ::flock( fd, LOCK_EX ) != 0 ) {
+        ::close( fd );
+        return -1;
+    }
+    return fd;
+}
+
+bool write_summary( int fd, std::uintmax_t const size ) {
+    auto const text = std::format( "{:0{}}", size, summary_width );
+    return ::pwrite( fd, text.data(), text.size(), 0 ) == static_cast<ssize_t>( text.size() );
+}
+
+} // namespace
+
+CompileCache::CompileCache( std::filesystem::path directory, std::uintmax_t const max_size )
+    : directory( std::move( directory ) ), summary( this->directory / "size" ), max_size( max_size ) {
+    std::filesystem::create_directories( this->directory );
+    std::lock_guard lock( mutex );
+    if ( auto const size = add_size( 0, 0 ); !size || *size > max_size ) {
+        evict();
+    }
+}
+
+std::filesystem::path CompileCache::path( std::string const& key ) const {
+    // Spread the entries over 256 directories.
+    return directory / key.substr( 0, 2 ) / ( key.substr( 2 ) + ".s" );
+}
+
+std::optional<std::string> CompileCache::get( std::string const& key ) {
+    auto const    file = path( key );
+    std::ifstream input { file, std::ios::binary };
+    if ( !input ) {
+        ++miss_count;
+        return std::nullopt;
+    }
+    std::ostringstream data;
+    data << input.rdbuf();
+    ++hit_count;
+
+    // Mark it as used. It may have been removed by another process, which doesn't matter.
+    std::error_code error;
+    std::filesystem::last_write_time( file, std::filesystem::file_time_type::clock::now(), error );
+    return std::move( data ).str();
+}
+
+void CompileCache::put( std::string const& key, std::string_view const data ) {
+    auto const      file = path( key );
+    std::error_code error;
+    std::filesystem::create_directories( file.parent_path(), error );
+    std::error_code replaced_error;
+    auto const      replaced = std::filesystem::file_size( file, replaced_error );
+
+    // Readers see the whole entry or none of it.
+    auto const temp = std::format( "{}.{}.{}.tmp", file.string(), getpid(), temp_count++ );
+    {
+        std::ofstream output { temp, std::ios::binary };
+        output.write( data.data(), static_cast<std::streamsize>( data.size() ) );
+        if ( !output ) {
+            output.close();
+            std::filesystem::remove( temp, error );
+            return; // not cached, which is not an error
+        }
+    }
+    std::filesystem::rename( temp, file, error );
+    if ( error ) {
+        std::filesystem::remove( temp, error );
+        return;
+    }
+
+    std::lock_guard lock( mutex );
+    if ( auto const size = add_size( data.size(), replaced_error ? 0 : replaced ); !size || *size > max_size ) {
+        evict();
+    }
+}
+
+std::optional<std::uintmax_t> CompileCache::add_size( std::uintmax_t const added, std::uintmax_t const removed ) const {
+    int const fd = lock_summary( summary );
+    if ( fd < 0 ) {
+        return std::nullopt;
+    }
+    char           text[ summary_width ];
+    auto const     length = ::pread( fd, text, sizeof( text ), 0 );
+    std::uintmax_t size = 0;
+    auto const [ end, ec ] = std::from_chars( text, text + std::max<ssize_t>( length, 0 ), size );
+    bool const known = ec == std::errc {} && end == text + summary_width;
+    if ( known ) {
+        size = size + added - std::min( size + added, removed );
+        write_summary( fd, size );
+    }
+    ::close( fd );
+    return known ? std::optional( size ) : std::nullopt;
+}
+
+void CompileCache::store_size( std::uintmax_t const size ) const {
+    if ( int const fd = lock_summary( summary ); fd >= 0 ) {
+        write_summary( fd, size );
+        ::close( fd );
+    }
+}
+
+void CompileCache::evict() {
+    struct Entry {
+        std::filesystem::file_time_type time;
+        std::uintmax_t                  size;
+        std::filesystem::path           path;
+    };
+    std::vector<Entry> entries;
+    std::uintmax_t     size = 0;
+    std::error_code    error;
+    for ( auto const& item : std::filesystem::recursive_directory_iterator( directory, error ) ) {
+        std::error_code item_error;
+        if ( !item.is_regular_file( item_error ) || item.path().extension() != ".s" ) {
+            continue; // including the temporary files being written
+        }
+        auto const time = item.last_write_time( item_error );
+        auto const file_size = item.file_size( item_error );
+        if ( !item_error ) {
+            entries.push_back( { time, file_size, item.path() } );
+            size += file_size;
+        }
+    }
+    if ( size > max_size ) {
+        // Remove the least recently used down to 90% of the maximum, so that the next entries don't scan again.
+        std::ranges::sort( entries, {}, &Entry::time );
+        for ( auto const& entry : entries ) {
+            if ( size <= max_size / 10 * 9 ) {
+                break;
+            }
+            std::filesystem::remove( entry.path, error );
+            size -= entry.size;
+        }
+    }
+    // Entries written by other processes during the scan are not counted, until the next scan.
+    store_size( size );
+}
@@ -0,0 +1,65 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "option.h"
+#include "token.h"
+
+// Changed when the compiler's output changes, so that the results of an older compiler are not used.
+constexpr std::string_view compiler_version = "axc 0.1";
+
+constexpr std::uintmax_t default_cache_size = 256 * 1024 * 1024;
+
+// The key of a compilation: a hash of the preprocessed tokens, the options which change the assembly, and the
+// compiler version.
+std::string compile_key( std::vector<Token> const& tokens, Option const& option );
+
+// An on-disk cache of the assembly of compilations, like ccache, and of functions for the x86_64 code generator. An
+// entry is a file named by its key, written to a temporary file and renamed, so the cache can be shared by the threads
+// of a batch compile and by other processes. Using an entry updates its modification time; when the cache is larger
+// than its maximum size, the least recently used entries are removed.
+//
+// The total size of the entries is kept in a summary file, changed under a file lock, so that opening the cache and
+// writing an entry don't scan the directory. It is only scanned when the summary is missing or over the maximum.
+class CompileCache {
+  public:
+    CompileCache( std::filesystem::path directory, std::uintmax_t max_size = default_cache_size );
+
+    std::optional<std::string> get( std::string const& key );
+    void                       put( std::string const& key, std::string_view data );
+
+    [[nodiscard]] size_t hits() const { return hit_count; }
+    [[nodiscard]] size_t misses() const { return miss_count; }
+
+  private:
+    [[nodiscard]] std::filesystem::path path( std::string const& key ) const;
+    std::optional<std::uintmax_t>       add_size( std::uintmax_t added, std::uintmax_t removed ) const;
+    void                                store_size( std::uintmax_t size ) const;
+    void                                evict();
+
+    std::filesystem::path directory;
+    std::filesystem::path summary;
+    std::uintmax_t        max_size;
+
+    std::mutex          mutex; // one eviction at a time
+    std::atomic<size_t> temp_count { 0 };
+    std::atomic<size_t> hit_count { 0 };
+    std::atomic<size_t> miss_count { 0 };
+};
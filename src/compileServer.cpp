@@ -0,0 +1,383 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "compileServer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+namespace {
+
+constexpr int poll_interval = 100; // ms between checks for stop
+
+constexpr std::string_view to_string( System s ) {
+    switch ( s ) {
+    case System::Linux :
+        return "linux";
+    case System::FreeBSD :
+        return "freebsd";
+    case System::MacOS :
+        return "macos";
+    }
+    return "macos";
+}
+
+// Append a header line. Values are single lines, so new lines are replaced.
+void add_field( std::string& message, std::string_view key, std::string_view value ) {
+    message += key;
+    message += ": ";
+    for ( char const c : value ) {
+        message += c == '\n' ? ' ' : c;
+    }
+    message += '\n';
+}
+
+void add_body( std::string& message, std::string_view body ) {
+    add_field( message, "length", std::to_string( body.size() ) );
+    message += '\n';
+    message += body;
+}
+
+// Split a message into its header fields and body. Returns false if the message is malformed.
+bool split_message( std::string_view message, std::vector<std::pair<std::string_view, std::string_view>>& fields,
+                    std::string_view& body ) {
+    auto const end = message.find( "\n\n" );
+    if ( end == std::string_view::npos ) {
+        return false;
+    }
+    size_t length = 0;
+    bool   has_length = false;
+    for ( auto const line : std::views::split( message.substr( 0, end ), '\n' ) ) {
+        std::string_view const text( line.begin(), line.end() );
+        auto const             colon = text.find( ": " );
+        if ( colon == std::string_view::npos ) {
+            return false;
+        }
+        auto const key = text.substr( 0, colon );
+        auto const value = text.substr( colon + 2 );
+        if ( key == "length" ) {
+            auto [ _, ec ] = std::from_chars( value.data(), value.data() + value.size(), length );
+            has_length = ec == std::errc {};
+        } else {
+            fields.emplace_back( key, value );
+        }
+    }
+    body = message.substr( end + 2 );
+    return has_length && body.size() == length;
+}
+
+bool write_all( int fd, char const* data, size_t size ) {
+    while ( size > 0 ) {
+        auto const n = ::send( fd, data, size, MSG_NOSIGNAL );
+        if ( n < 0 && errno == EINTR ) {
+            continue;
+        }
+        if ( n <= 0 ) {
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool read_all( int fd, char* data, size_t size ) {
+    while ( size > 0 ) {
+        auto const n = ::read( fd, data, size );
+        if ( n < 0 && errno == EINTR ) {
+            continue;
+        }
+        if ( n <= 0 ) {
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+// Closes the socket when it goes out of scope.
+class Socket {
+  public:
+    explicit Socket( int fd ) : fd( fd ) {}
+    Socket( Socket const& ) = delete;
+    Socket& operator=( Socket const& ) = delete;
+    ~Socket() { ::close( fd ); }
+
+    [[nodiscard]] int get() const { return fd; }
+
+  private:
+    int fd;
+};
+
+sockaddr_un socket_address( std::string const& path ) {
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if ( path.size() >= sizeof( address.sun_path ) ) {
+        throw std::runtime_error( std::format( "Socket path too long: {}", path ) );
+    }
+    std::ranges::copy( path, address.sun_path );
+    return address;
+}
+
+} // namespace
+
+std::string encode_request( CompileRequest const& request ) {
+    std::string message;
+    add_field( message, "file", request.file );
+    add_field( message, "machine", to_string( request.machine ) );
+    add_field( message, "os", to_string( request.system ) );
+    add_field( message, "opt", std::to_string( request.opt_level ) );
+    for ( auto const& pass : request.passes ) {
+        add_field( message, "pass", pass );
+    }
+    for ( auto const& path : request.include_paths ) {
+        add_field( message, "include", path );
+    }
+    for ( auto const& definition : request.defines ) {
+        add_field( message, "define", definition );
+    }
+    add_body( message, request.source );
+    return message;
+}
+
+std::optional<CompileRequest> decode_request( std::string_view message ) {
+    std::vector<std::pair<std::string_view, std::string_view>> fields;
+    std::string_view                                           body;
+    if ( !split_message( message, fields, body ) ) {
+        return std::nullopt;
+    }
+    CompileRequest request;
+    for ( auto const& [ key, value ] : fields ) {
+        if ( key == "file" ) {
+            request.file = value;
+        } else if ( key == "machine" ) {
+            if ( value == to_string( Machine::AArch64 ) ) {
+                request.machine = Machine::AArch64;
+            } else if ( value == to_string( Machine::X86_64 ) ) {
+                request.machine = Machine::X86_64;
+            } else {
+                return std::nullopt;
+            }
+        } else if ( key == "os" ) {
+            if ( value == "linux" ) {
+                request.system = System::Linux;
+            } else if ( value == "freebsd" ) {
+                request.system = System::FreeBSD;
+            } else if ( value == "macos" ) {
+                request.system = System::MacOS;
+            } else {
+                return std::nullopt;
+            }
+        } else if ( key == "opt" ) {
+            auto [ _, ec ] = std::from_chars( value.data(), value.data() + value.size(), request.opt_level );
+            if ( ec != std::errc {} ) {
+                return std::nullopt;
+            }
+        } else if ( key == "pass" ) {
+            request.passes.emplace_back( value );
+        } else if ( key == "include" ) {
+            request.include_paths.emplace_back( value );
+        } else if ( key == "define" ) {
+            request.defines.emplace_back( value );
+        }
+    }
+    request.source = body;
+    return request;
+}
+
+std::string encode_result( CompileResult const& result ) {
+    std::string message;
+    add_field( message, "status", result.success ? "ok" : "error" );
+    for ( auto const& diagnostic : result.diagnostics ) {
+        add_field( message, "diagnostic", diagnostic );
+    }
+    add_body( message, result.assembly );
+    return message;
+}
+
+std::optional<CompileResult> decode_result( std::string_view message ) {
+    std::vector<std::pair<std::string_view, std::string_view>> fields;
+    std::string_view                                           body;
+    if ( !split_message( message, fields, body ) ) {
+        return std::nullopt;
+    }
+    CompileResult result;
+    for ( auto const& [ key, value ] : fields ) {
+        if ( key == "status" ) {
+            result.success = value == "ok";
+        } else if ( key == "diagnostic" ) {
+            result.diagnostics.emplace_back( value );
+        }
+    }
+    result.assembly = body;
+    return result;
+}
+
+bool read_message( int fd, std::string& message ) {
+    // The header is short, so read it a byte at a time to leave any following message on the socket.
+    message.clear();
+    while ( !message.ends_with( "\n\n" ) ) {
+        if ( message.size() >= max_header_size ) {
+            throw std::length_error( std::format( "Message header longer than {} bytes", max_header_size ) );
+        }
+        char c;
+        if ( !read_all( fd, &c, 1 ) ) {
+            return false;
+        }
+        message += c;
+    }
+    auto const start = message.rfind( "length: " );
+    if ( start == std::string::npos ) {
+        return false;
+    }
+    size_t length = 0;
+    auto [ _, ec ] = std::from_chars( message.data() + start + 8, message.data() + message.size(), length );
+    if ( ec != std::errc {} ) {
+        return false;
+    }
+    if ( length > max_body_size ) {
+        throw std::length_error( std::format( "Message body of {} bytes is longer than {}", length, max_body_size ) );
+    }
+    auto const header = message.size();
+    message.resize( header + length );
+    return read_all( fd, message.data() + header, length );
+}
+
+bool write_message( int fd, std::string_view message ) {
+    return write_all( fd, message.data(), message.size() );
+}
+
+CompileServer::CompileServer( std::string socket_path, Option const& options )
+    : socket_path( std::move( socket_path ) ), options( options ),
+      pool( options.jobs == 0 ? std::thread::hardware_concurrency() : static_cast<size_t>( options.jobs ), nullptr,
+            "connection" ) {
+    this->options.include_cache = &include_cache;
+}
+
+CompileServer::~CompileServer() {
+    if ( listener >= 0 ) {
+        ::close( listener );
+        ::unlink( socket_path.c_str() );
+    }
+}
+
+void CompileServer::run() {
+    auto const address = socket_address( socket_path );
+    listener = ::socket( AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0 );
+    if ( listener < 0 ) {
+        throw std::runtime_error( std::format( "Cannot create socket: {}", std::strerror( errno ) ) );
+    }
+    ::unlink( socket_path.c_str() );
+    if ( ::bind( listener, reinterpret_cast<sockaddr const*>( &address ), sizeof( address ) ) < 0 ||
+         ::listen( listener, SOMAXCONN ) < 0 ) {
+        throw std::runtime_error( std::format( "Cannot listen on {}: {}", socket_path, std::strerror( errno ) ) );
+    }
+    spdlog::info( "Serving on {} with {} threads", socket_path, pool.size() );
+
+    pollfd listen_poll { .fd = listener, .events = POLLIN, .revents = 0 };
+    while ( !stopping ) {
+        if ( ::poll( &listen_poll, 1, poll_interval ) <= 0 ) {
+            continue;
+        }
+        int const client = ::accept4( listener, nullptr, nullptr, SOCK_CLOEXEC );
+        if ( client < 0 ) {
+            continue;
+        }
+        pool.submit( [ this, client ] {
+            Socket const socket( client );
+            try {
+                serve( socket.get() );
+            } catch ( const std::exception& err ) {
+                spdlog::error( "Connection failed: {}", err.what() );
+            }
+        } );
+    }
+    spdlog::info( "Server stopping" );
+    pool.wait();
+}
+
+void CompileServer::serve( int client ) const {
+    pollfd      client_poll { .fd = client, .events = POLLIN, .revents = 0 };
+    std::string message;
+    while ( !stopping ) {
+        if ( ::poll( &client_poll, 1, poll_interval ) <= 0 ) {
+            continue;
+        }
+        try {
+            if ( !read_message( client, message ) ) {
+                return;
+            }
+        } catch ( const std::length_error& err ) {
+            // The rest of the message is not read, so the connection cannot be used again.
+            CompileResult result;
+            result.diagnostics.emplace_back( std::format( "Server: {}", err.what() ) );
+            write_message( client, encode_result( result ) );
+            return;
+        }
+        CompileResult result;
+        if ( auto request = decode_request( message ) ) {
+            result = compile_request( *request );
+        } else {
+            result.diagnostics.emplace_back( "Server: malformed request" );
+        }
+        if ( !write_message( client, encode_result( result ) ) ) {
+            return;
+        }
+    }
+}
+
+CompileResult CompileServer::compile_request( CompileRequest const& request ) const {
+    Option option = options;
+    option.input_file = request.file;
+    option.machine = request.machine;
+    option.system = request.system;
+    option.opt_level = request.opt_level;
+    option.passes = request.passes;
+    option.include_paths = request.include_paths;
+    option.defines = request.defines;
+    option.input_files.clear();
+    return compile_source( request.source, option );
+}
+
+CompileResult compile_remote( std::string const& socket_path, CompileRequest const& request ) {
+    auto const address = socket_address( socket_path );
+    int const  fd = ::socket( AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0 );
+    if ( fd < 0 ) {
+        throw std::runtime_error( std::format( "Cannot create socket: {}", std::strerror( errno ) ) );
+    }
+    Socket const socket( fd );
+    if ( ::connect( fd, reinterpret_cast<sockaddr const*>( &address ), sizeof( address ) ) < 0 ) {
+        throw std::runtime_error( std::format( "Cannot connect to {}: {}", socket_path, std::strerror( errno ) ) );
+    }
+    std::string message;
+    if ( !write_message( fd, encode_request( request ) ) || !read_message( fd, message ) ) {
+        throw std::runtime_error( std::format( "Lost connection to {}", socket_path ) );
+    }
+    auto result = decode_result( message );
+    if ( !result ) {
+        throw std::runtime_error( std::format( "Malformed reply from {}", socket_path ) );
+    }
+    return std::move( *result );
+}
@@ -0,0 +1,83 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "compiler.h"
+#include "includeCache.h"
+#include "option.h"
+#include "threadPool.h"
+
+// A request to the compile server: a source and the options for compiling it.
+struct CompileRequest {
+    std::string              file; // name of the source, used in the assembly
+    Machine                  machine { Machine::X86_64 };
+    System                   system { System::MacOS };
+    int                      opt_level { 0 };
+    std::vector<std::string> passes;
+    std::vector<std::string> include_paths;
+    std::vector<std::string> defines;
+    std::string              source;
+};
+
+// Messages are a header of "key: value" lines, a blank line, then a body of the length given by the "length" key.
+std::string                   encode_request( CompileRequest const& request );
+std::optional<CompileRequest> decode_request( std::string_view message );
+std::string                   encode_result( CompileResult const& result );
+std::optional<CompileResult>  decode_result( std::string_view message );
+
+// The largest header and body of a message which are read.
+constexpr size_t max_header_size = 64 << 10;
+constexpr size_t max_body_size = 256 << 20;
+
+// Read or write one message on a socket. read_message returns false at the end of the connection, and throws
+// std::length_error for a message larger than the limits.
+bool read_message( int fd, std::string& message );
+bool write_message( int fd, std::string_view message );
+
+// --serve: a long running compiler listening on a Unix domain socket. Each connection can send any number of requests,
+// and the connections are served at the same time on a pool of threads. A connection holds its thread until it is
+// closed, so option.jobs is the most clients served at once, and others wait; 0 is one per hardware thread.
+class CompileServer {
+  public:
+    // Compilations use the options, with the machine, system and optimisation from each request.
+    CompileServer( std::string socket_path, Option const& options );
+    ~CompileServer();
+
+    CompileServer( CompileServer const& ) = delete;
+    CompileServer& operator=( CompileServer const& ) = delete;
+
+    // Serve requests until stop is called. Throws if the socket cannot be opened.
+    void run();
+
+    // Can be called from a signal handler.
+    void stop() { stopping = true; }
+
+  private:
+    void          serve( int client ) const;
+    CompileResult compile_request( CompileRequest const& request ) const;
+
+    std::string       socket_path;
+    Option            options;
+    IncludeCache      include_cache; // kept between requests
+    ThreadPool        pool;
+    int               listener { -1 };
+    std::atomic<bool> stopping { false };
+};
+
+// --connect: send a request to the server at the socket and wait for the result. Throws if the server cannot be
+// reached.
+CompileResult compile_remote( std::string const& socket_path, CompileRequest const& request );
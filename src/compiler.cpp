@@ -0,0 +1,200 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "compiler.h"
+
+#include <format>
+#include <iterator>
+#include <optional>
+
+#include "codeGen.h"
+#include "compileCache.h"
+#include "dump.h"
+#include "exception.h"
+#include "instrument.h"
+#include "lexer.h"
+#include "parser.h"
+#include "preprocessor.h"
+#include "printerAST.h"
+#include "printerTAC.h"
+#include "semanticAnalyser.h"
+#include "tacGen.h"
+#include "tacPasses.h"
+
+ast::Program run_parser( TokenStream& lexer, CompilationContext& context ) {
+    context.logger->info( "Run parser," );
+    Region region( context.option.instrument, "parse" );
+    Parser parser { lexer, context };
+    auto   program = parser.parse();
+
+    if ( context.option.dump_ast ) {
+        PrinterAST printer;
+        dump( context.option, "Parsing Output", printer.print( program ) );
+    }
+    return program;
+}
+
+void run_sematic( ast::Program program, CompilationContext& context ) {
+    context.logger->info( "Run semantic anylser," );
+    Region           region( context.option.instrument, "semantic" );
+    SemanticAnalyser analyser { context };
+    analyser.analyse( program );
+
+    if ( context.option.dump_sema ) {
+        PrinterAST printer;
+        dump( context.option, "Semantic Output", printer.print( program ) );
+        context.symbol_table.dump( context.option.dump_file );
+    }
+}
+
+tac::Program run_tac( ast::Program program, CompilationContext& context ) {
+    context.logger->info( "Run TAC generator," );
+    tac::Program tac;
+    {
+        Region region( context.option.instrument, "tac" );
+        TacGen tac_generator( context );
+        tac = tac_generator.generate( program );
+    }
+
+    auto passes = make_tac_passes( context );
+    passes.run( tac );
+
+    if ( context.option.dump_tac ) {
+        PrinterTAC tac_printer;
+        dump( context.option, "TAC Output", tac_printer.print( tac ) );
+    }
+    return tac;
+}
+
+std::string compile( CompilationContext& context, std::string_view const source ) {
+    auto const& options = context.option;
+    try {
+        // Run Lexer, through the preprocessor
+        context.logger->info( "Run lexer," );
+        std::optional<Preprocessor> lexer;
+        {
+            Region region( options.instrument, "lex" );
+            lexer.emplace( source, context );
+        }
+
+        if ( ( options.stage & Stages::Parse ) == 0 ) {
+            std::string tokens;
+            for ( Token token = lexer->get_token(); token.tok != TokenType::Eof; token = lexer->get_token() ) {
+                tokens += std::format( "{} {} \n", token.location, ( token ) );
+            }
+            return tokens + "\n";
+        }
+
+        // With a compile cache, the file is preprocessed first to find its key, and the assembly is used if found. When
+        // dumping, the file is always compiled, and its assembly still stored.
+        std::optional<TokenBuffer> tokens;
+        std::string                key;
+        if ( options.compile_cache && options.stage == Stages::All ) {
+            Region region( options.instrument, "cache" );
+            tokens.emplace( *lexer );
+            key = compile_key( tokens->tokens(), options );
+            if ( auto assembly = options.dumping() ? std::nullopt : options.compile_cache->get( key ) ) {
+                context.logger->info( "Found in the compile cache," );
+                return std::move( *assembly );
+            }
+        }
+
+        // Run Parser
+        auto program = run_parser( tokens ? static_cast<TokenStream&>( *tokens ) : *lexer, context );
+
+        if ( ( options.stage & Stages::Semantic ) == 0 ) {
+            return {};
+        }
+
+        run_sematic( program, context );
+
+        if ( ( options.stage & Stages::Tac ) == 0 ) {
+            return {};
+        }
+
+        // Run TAC Generator
+        auto tac = run_tac( program, context );
+
+        if ( ( options.stage & Stages::CodeGen ) == 0 ) {
+            return {};
+        }
+
+        // Run Code Gen
+        auto codeGenerator = make_CodeGen( context );
+        if ( !codeGenerator ) {
+            throw CodeException( Location {}, "Cannot create code generator for machine: {}",
+                                 to_string( options.machine ) );
+        }
+
+        CodeGenBase assembly;
+        {
+            Region region( options.instrument, "codegen" );
+            assembly = codeGenerator->run_codegen( tac );
+        }
+
+        if ( ( options.stage & Stages::File ) == 0 ) {
+            return {};
+        }
+
+        std::string output;
+        {
+            Region region( options.instrument, "emit" );
+            output = codeGenerator->generate_assembly( assembly );
+        }
+        if ( tokens ) {
+            options.compile_cache->put( key, output );
+        }
+        return output;
+
+    } catch ( const LexicalException& e ) {
+        context.diagnostics.error( std::format( "Lexical error: {}", e.get_message() ) );
+    } catch ( const PreprocessorException& e ) {
+        context.diagnostics.error( std::format( "Preprocessor error: {}", e.get_message() ) );
+    } catch ( const ParseException& e ) {
+        context.diagnostics.error( std::format( "Parse error: {}", e.get_message() ) );
+    } catch ( const SemanticException& e ) {
+        context.diagnostics.error( std::format( "Semantic error: {}", e.get_message() ) );
+    } catch ( const CodeException& e ) {
+        context.diagnostics.error( std::format( "Code Generation: {}", e.get_message() ) );
+    } catch ( const std::exception& err ) {
+        context.diagnostics.error( std::format( "Exception: {}", err.what() ) );
+    }
+    return {};
+}
+
+std::string compile( CompilationContext& context, std::istream& source ) {
+    std::string const text( std::istreambuf_iterator<char>( source.rdbuf() ), std::istreambuf_iterator<char>() );
+    return compile( context, std::string_view( text ) );
+}
+
+CompileResult compile_source( const std::string_view source, Option const& option ) {
+    CompilationContext context( option );
+    context.option.stage = Stages::All;
+
+    CompileResult result;
+    result.assembly = compile( context, source );
+    result.success = !context.diagnostics.has_errors();
+    result.diagnostics.assign( context.diagnostics.begin(), context.diagnostics.end() );
+    return result;
+}
+
+std::optional<Prelude> compile_prelude( CompilationContext& context, std::istream& source ) {
+    context.option.stage = static_cast<Stages>( Stages::Lex | Stages::Parse | Stages::Semantic );
+    compile( context, source );
+    if ( context.diagnostics.has_errors() ) {
+        return std::nullopt;
+    }
+    try {
+        return make_prelude( context.option.input_file, context.symbol_table );
+    } catch ( const std::exception& err ) {
+        context.diagnostics.error( std::format( "Semantic error: {}", err.what() ) );
+    }
+    return std::nullopt;
+}
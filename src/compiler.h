@@ -0,0 +1,42 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <istream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "compilationContext.h"
+#include "option.h"
+#include "prelude.h"
+
+// Run the stages set in the options of the context over the source. Errors are added to the diagnostics of the
+// context. Returns the tokens when only the lexer is run, the assembly when the File stage is run, otherwise nothing.
+std::string compile( CompilationContext& context, std::string_view source );
+std::string compile( CompilationContext& context, std::istream& source );
+
+struct CompileResult {
+    bool                     success { false };
+    std::string              assembly;
+    std::vector<std::string> diagnostics;
+};
+
+// Compile a buffer of C source to assembly in memory, for the machine and system in the options. The source is not
+// read from option.input_file, which names it in the assembly and is where its #include files are looked for. The
+// filesystem is used for those files, for the source of option.prelude to check it is current, and for the entries
+// of option.compile_cache.
+CompileResult compile_source( std::string_view source, Option const& option );
+
+// Compile option.input_file, a file of extern declarations, to a prelude. Errors, including a definition in the
+// file, are added to the diagnostics of the context.
+std::optional<Prelude> compile_prelude( CompilationContext& context, std::istream& source );
@@ -0,0 +1,264 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 16/10/2026.
+//
+
+#include "constantFold.h"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+#include <spdlog/spdlog.h>
+
+#include "common.h"
+#include "tac/includes.h"
+
+namespace {
+
+std::optional<std::int64_t> fold_constant( tac::Value const& value ) {
+    if ( auto i = std::get_if<tac::ConstantInt>( &value ) ) {
+        return ( *i )->value;
+    }
+    if ( auto l = std::get_if<tac::ConstantLong>( &value ) ) {
+        return ( *l )->value;
+    }
+    return std::nullopt;
+}
+
+Type fold_type( tac::Value const& value ) {
+    return std::visit( overloaded { []( tac::ConstantInt ) -> Type { return Type::INT; },
+                                    []( tac::ConstantLong ) -> Type { return Type::LONG; },
+                                    []( tac::Variable v ) -> Type { return v->type; } },
+                       value );
+}
+
+// Wrap the result to the size of the type, as the machine would.
+std::int64_t fold_wrap( const std::uint64_t value, const Type type ) {
+    if ( type == Type::LONG ) {
+        return static_cast<std::int64_t>( value );
+    }
+    return static_cast<std::int32_t>( static_cast<std::uint32_t>( value ) );
+}
+
+tac::Value fold_result( HasLocation auto b, const Type type, const std::int64_t value ) {
+    if ( type == Type::LONG ) {
+        return mk_node<tac::ConstantLong_>( b, value );
+    }
+    return mk_node<tac::ConstantInt_>( b, static_cast<std::int32_t>( value ) );
+}
+
+std::optional<std::int64_t> fold_binary( const tac::BinaryOpType op, const std::int64_t a, const std::int64_t b,
+                                         const Type type ) {
+    auto const ua = static_cast<std::uint64_t>( a );
+    auto const ub = static_cast<std::uint64_t>( b );
+    auto const bits = type == Type::LONG ? 64 : 32;
+    auto const min = type == Type::LONG ? std::numeric_limits<std::int64_t>::min()
+                                        : std::numeric_limits<std::int32_t>::min();
+    switch ( op ) {
+    case tac::BinaryOpType::Add :
+        return fold_wrap( ua + ub, type );
+    case tac::BinaryOpType::Subtract :
+        return fold_wrap( ua - ub, type );
+    case tac::BinaryOpType::Multiply :
+        return fold_wrap( ua * ub, type );
+    case tac::BinaryOpType::Divide :
+        // Leave the trap to run time
+        if ( b == 0 || ( a == min && b == -1 ) ) {
+            return std::nullopt;
+        }
+        return a / b;
+    case tac::BinaryOpType::Modulo :
+        if ( b == 0 || ( a == min && b == -1 ) ) {
+            return std::nullopt;
+        }
+        return a % b;
+    case tac::BinaryOpType::BitwiseAnd :
+        return a & b;
+    case tac::BinaryOpType::BitwiseOr :
+        return a | b;
+    case tac::BinaryOpType::BitwiseXor :
+        return a ^ b;
+    case tac::BinaryOpType::ShiftLeft :
+        if ( b < 0 || b >= bits ) {
+            return std::nullopt;
+        }
+        return fold_wrap( ua << b, type );
+    case tac::BinaryOpType::ShiftRight :
+        if ( b < 0 || b >= bits ) {
+            return std::nullopt;
+        }
+        return a >> b;
+    case tac::BinaryOpType::Equal :
+        return a == b;
+    case tac::BinaryOpType::NotEqual :
+        return a != b;
+    case tac::BinaryOpType::Less :
+        return a < b;
+    case tac::BinaryOpType::LessEqual :
+        return a <= b;
+    case tac::BinaryOpType::Greater :
+        return a > b;
+    case tac::BinaryOpType::GreaterEqual :
+        return a >= b;
+    case tac::BinaryOpType::And :
+        return a && b;
+    case tac::BinaryOpType::Or :
+        return a || b;
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+void ConstantFold::run_on_function( const tac::FunctionDef function ) {
+    std::vector<tac::Instruction> instructions;
+    instructions.reserve( function->instructions.size() );
+    constants.clear();
+    for ( auto const& instr : function->instructions ) {
+        std::visit(
+            overloaded {
+                [ this, &instructions ]( tac::Unary u ) -> void { instructions.push_back( unary( u ) ); },
+                [ this, &instructions ]( tac::Binary b ) -> void { instructions.push_back( binary( b ) ); },
+                [ this, &instructions ]( tac::Copy c ) -> void {
+                    c->src = propagate( c->src );
+                    assign( c->dst, c->src );
+                    instructions.push_back( c );
+                },
+                [ this, &instructions ]( tac::SignExtend s ) -> void {
+                    s->src = propagate( s->src );
+                    if ( auto c = fold_constant( s->src ) ) {
+                        auto copy = mk_node<tac::Copy_>( s, mk_node<tac::ConstantLong_>( s, *c ), s->dst );
+                        assign( copy->dst, copy->src );
+                        instructions.push_back( copy );
+                        return;
+                    }
+                    forget( s->dst );
+                    instructions.push_back( s );
+                },
+                [ this, &instructions ]( tac::Truncate t ) -> void {
+                    t->src = propagate( t->src );
+                    if ( auto c = fold_constant( t->src ) ) {
+                        auto copy = mk_node<tac::Copy_>( t, fold_result( t, Type::INT, fold_wrap( *c, Type::INT ) ),
+                                                         t->dst );
+                        assign( copy->dst, copy->src );
+                        instructions.push_back( copy );
+                        return;
+                    }
+                    forget( t->dst );
+                    instructions.push_back( t );
+                },
+                [ this, &instructions ]( tac::JumpIfZero j ) -> void {
+                    j->condition = propagate( j->condition );
+                    if ( auto c = fold_constant( j->condition ) ) {
+                        // Either always jumps or never jumps
+                        if ( *c == 0 ) {
+                            instructions.push_back( mk_node<tac::Jump_>( j, j->target ) );
+                        }
+                        return;
+                    }
+                    instructions.push_back( j );
+                },
+                [ this, &instructions ]( tac::JumpIfNotZero j ) -> void {
+                    j->condition = propagate( j->condition );
+                    if ( auto c = fold_constant( j->condition ) ) {
+                        if ( *c != 0 ) {
+                            instructions.push_back( mk_node<tac::Jump_>( j, j->target ) );
+                        }
+                        return;
+                    }
+                    instructions.push_back( j );
+                },
+                [ this, &instructions ]( tac::Return r ) -> void {
+                    r->value = propagate( r->value );
+                    instructions.push_back( r );
+                },
+                [ this, &instructions ]( tac::FunCall f ) -> void {
+                    for ( auto& arg : f->arguments ) {
+                        arg = propagate( arg );
+                    }
+                    // The call can change static variables.
+                    constants.clear();
+                    instructions.push_back( f );
+                },
+                [ this, &instructions ]( tac::Label l ) -> void {
+                    // Start of a basic block, values can arrive from elsewhere.
+                    constants.clear();
+                    instructions.push_back( l );
+                },
+                [ &instructions ]( auto i ) -> void { instructions.push_back( i ); } },
+            instr );
+    }
+    logger->debug( "constfold: {} {} -> {} instructions", function->name, function->instructions.size(),
+                   instructions.size() );
+    function->instructions = std::move( instructions );
+}
+
+tac::Value ConstantFold::propagate( tac::Value const& value ) const {
+    if ( auto const* v = std::get_if<tac::Variable>( &value ) ) {
+        if ( auto const c = constants.find( ( *v )->name ); c != constants.end() ) {
+            return c->second;
+        }
+    }
+    return value;
+}
+
+void ConstantFold::assign( tac::Value const& dst, tac::Value const& src ) {
+    auto const* v = std::get_if<tac::Variable>( &dst );
+    if ( v != nullptr && fold_constant( src ) ) {
+        constants[ ( *v )->name ] = src;
+        return;
+    }
+    forget( dst );
+}
+
+void ConstantFold::forget( tac::Value const& dst ) {
+    if ( auto const* v = std::get_if<tac::Variable>( &dst ) ) {
+        constants.erase( ( *v )->name );
+    }
+}
+
+tac::Instruction ConstantFold::unary( const tac::Unary atac ) {
+    atac->src = propagate( atac->src );
+    auto const c = fold_constant( atac->src );
+    if ( !c ) {
+        forget( atac->dst );
+        return atac;
+    }
+    auto const type = fold_type( atac->src );
+    std::int64_t result = 0;
+    switch ( atac->op ) {
+    case tac::UnaryOpType::Negate :
+        result = fold_wrap( 0 - static_cast<std::uint64_t>( *c ), type );
+        break;
+    case tac::UnaryOpType::Complement :
+        result = fold_wrap( ~static_cast<std::uint64_t>( *c ), type );
+        break;
+    case tac::UnaryOpType::Not :
+        result = *c == 0;
+        break;
+    }
+    auto copy = mk_node<tac::Copy_>( atac, fold_result( atac, fold_type( atac->dst ), result ), atac->dst );
+    assign( copy->dst, copy->src );
+    return copy;
+}
+
+tac::Instruction ConstantFold::binary( const tac::Binary atac ) {
+    atac->src1 = propagate( atac->src1 );
+    atac->src2 = propagate( atac->src2 );
+    auto const a = fold_constant( atac->src1 );
+    auto const b = fold_constant( atac->src2 );
+    auto const result = a && b ? fold_binary( atac->op, *a, *b, fold_type( atac->src1 ) ) : std::nullopt;
+    if ( !result ) {
+        forget( atac->dst );
+        return atac;
+    }
+    auto copy = mk_node<tac::Copy_>( atac, fold_result( atac, fold_type( atac->dst ), *result ), atac->dst );
+    assign( copy->dst, copy->src );
+    return copy;
+}
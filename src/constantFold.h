@@ -0,0 +1,37 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 16/10/2026.
+//
+
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "tacPasses.h"
+
+// Constant folding: replace unary and binary operations, conversions and conditional jumps on constant operands
+// with their result. Constants copied into variables are propagated to later uses in the same basic block.
+class ConstantFold : public TacFunctionPass {
+  public:
+    ConstantFold() = default;
+    ~ConstantFold() override = default;
+
+    [[nodiscard]] std::string_view name() const override { return "constfold"; }
+    void                           run_on_function( tac::FunctionDef function ) override;
+
+  private:
+    tac::Instruction unary( tac::Unary atac );
+    tac::Instruction binary( tac::Binary atac );
+
+    tac::Value propagate( tac::Value const& value ) const;
+    void       assign( tac::Value const& dst, tac::Value const& src );
+    void       forget( tac::Value const& dst );
+
+    std::map<std::string, tac::Value> constants; // variables known to hold a constant
+};
@@ -0,0 +1,90 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 16/10/2026.
+//
+
+#include "deadCode.h"
+
+#include <set>
+
+#include <spdlog/spdlog.h>
+
+#include "common.h"
+#include "tac/includes.h"
+
+void DeadCode::run_on_function( const tac::FunctionDef function ) {
+    auto const before = function->instructions.size();
+    // Removing one thing can expose another, so repeat until nothing changes.
+    bool changed = true;
+    while ( changed ) {
+        changed = remove_unreachable( function->instructions );
+        changed |= remove_useless_jumps( function->instructions );
+        changed |= remove_unused_labels( function->instructions );
+    }
+    logger->debug( "dce: {} {} -> {} instructions", function->name, before, function->instructions.size() );
+}
+
+bool DeadCode::remove_unreachable( std::vector<tac::Instruction>& instructions ) {
+    std::vector<tac::Instruction> result;
+    result.reserve( instructions.size() );
+    bool reachable = true;
+    for ( auto const& instr : instructions ) {
+        if ( std::holds_alternative<tac::Label>( instr ) ) {
+            reachable = true;
+        }
+        if ( reachable ) {
+            result.push_back( instr );
+        }
+        if ( std::holds_alternative<tac::Jump>( instr ) || std::holds_alternative<tac::Return>( instr ) ) {
+            reachable = false;
+        }
+    }
+    if ( result.size() == instructions.size() ) {
+        return false;
+    }
+    instructions = std::move( result );
+    return true;
+}
+
+bool DeadCode::remove_useless_jumps( std::vector<tac::Instruction>& instructions ) {
+    std::vector<tac::Instruction> result;
+    result.reserve( instructions.size() );
+    for ( size_t i = 0; i < instructions.size(); ++i ) {
+        if ( i + 1 < instructions.size() ) {
+            if ( auto const* jump = std::get_if<tac::Jump>( &instructions[ i ] ) ) {
+                if ( auto const* label = std::get_if<tac::Label>( &instructions[ i + 1 ] ) ) {
+                    if ( ( *jump )->target == ( *label )->name ) {
+                        continue;
+                    }
+                }
+            }
+        }
+        result.push_back( instructions[ i ] );
+    }
+    if ( result.size() == instructions.size() ) {
+        return false;
+    }
+    instructions = std::move( result );
+    return true;
+}
+
+bool DeadCode::remove_unused_labels( std::vector<tac::Instruction>& instructions ) {
+    std::set<std::string> targets;
+    for ( auto const& instr : instructions ) {
+        std::visit( overloaded { [ &targets ]( tac::Jump j ) -> void { targets.insert( j->target ); },
+                                 [ &targets ]( tac::JumpIfZero j ) -> void { targets.insert( j->target ); },
+                                 [ &targets ]( tac::JumpIfNotZero j ) -> void { targets.insert( j->target ); },
+                                 []( auto ) -> void {} },
+                    instr );
+    }
+    auto const removed = std::erase_if( instructions, [ &targets ]( tac::Instruction const& instr ) {
+        auto const* label = std::get_if<tac::Label>( &instr );
+        return label != nullptr && !targets.contains( ( *label )->name );
+    } );
+    return removed > 0;
+}
@@ -0,0 +1,29 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 16/10/2026.
+//
+
+#pragma once
+
+#include "tacPasses.h"
+
+// Dead code elimination: remove instructions that can't be reached after a jump or return, jumps to the
+// following label, and labels that are never jumped to.
+class DeadCode : public TacFunctionPass {
+  public:
+    DeadCode() = default;
+    ~DeadCode() override = default;
+
+    [[nodiscard]] std::string_view name() const override { return "dce"; }
+    void                           run_on_function( tac::FunctionDef function ) override;
+
+  private:
+    static bool remove_unreachable( std::vector<tac::Instruction>& instructions );
+    static bool remove_useless_jumps( std::vector<tac::Instruction>& instructions );
+    static bool remove_unused_labels( std::vector<tac::Instruction>& instructions );
+};
@@ -0,0 +1,20 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 16/10/2026.
+//
+
+#include "dump.h"
+
+#include <print>
+#include <string>
+
+void dump( Option const& option, std::string_view title, std::string_view text ) {
+    std::println( option.dump_file, "{}:", title );
+    std::println( option.dump_file, "{}", std::string( title.size() + 1, '-' ) );
+    std::println( option.dump_file, "{:s}", text );
+}
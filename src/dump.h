@@ -0,0 +1,19 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 16/10/2026.
+//
+
+#pragma once
+
+#include <string_view>
+
+#include "option.h"
+
+// Write an IR dump, with a title, to the dump file. Callers check the dump option first, so that the printers
+// are not run at all on a normal compile.
+void dump( Option const& option, std::string_view title, std::string_view text );
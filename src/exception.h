@@ -29,19 +29,26 @@ class Exception : public std::exception {
     ~Exception() override = default;
 
     [[nodiscard]] std::string get_message() const {
-        if ( loc ) {
-            return to_string( *loc ) + " " + msg;
+        auto const message = loc ? to_string( *loc ) + " " + msg : msg;
+        if ( !file.empty() ) {
+            return file + ": " + message;
         }
-        return msg;
+        return message;
     }
 
     [[nodiscard]] std::optional<Location> const& get_location() const { return loc; };
 
+    // The file the location is in, when it is not the file being compiled.
+    void set_file( std::string f ) { file = std::move( f ); }
+
+    [[nodiscard]] std::string const& get_file() const { return file; }
+
   protected:
     explicit Exception( Location const& l ) : loc( l ) {};
 
     std::string             msg;
     std::optional<Location> loc;
+    std::string             file;
 };
 
 class LexicalException : public Exception {
@@ -56,6 +63,18 @@ class LexicalException : public Exception {
     ~LexicalException() override = default;
 };
 
+class PreprocessorException : public Exception {
+  public:
+    explicit PreprocessorException( std::string m ) : Exception( std::move( m ) ) {};
+    PreprocessorException( Location const& l, std::string m ) : Exception( l, std::move( m ) ) {};
+
+    template <typename... Args>
+    PreprocessorException( Location const& l, std::string fmt, const Args&... args ) : Exception( l ) {
+        msg = std::vformat( fmt, std::make_format_args( args... ) );
+    };
+    ~PreprocessorException() override = default;
+};
+
 class ParseException : public Exception {
   public:
     explicit ParseException( std::string m ) : Exception( std::move( m ) ) {};
@@ -0,0 +1,52 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// 128 bit FNV-1a hash, for the keys of the caches. Each value added is followed by its size, so that "ab", "c" hashes
+// differently from "a", "bc".
+class Hash {
+  public:
+    Hash& add( std::string_view data ) {
+        for ( auto const c : data ) {
+            state = ( state ^ static_cast<unsigned char>( c ) ) * prime;
+        }
+        return add_size( data.size() );
+    }
+
+    template <typename T>
+        requires std::integral<T> || std::is_enum_v<T>
+    Hash& add( T value ) {
+        auto const bits = static_cast<std::uint64_t>( value );
+        for ( size_t i = 0; i < sizeof( T ); ++i ) {
+            state = ( state ^ ( ( bits >> ( i * 8 ) ) & 0xff ) ) * prime;
+        }
+        return *this;
+    }
+
+    // 32 hex digits
+    [[nodiscard]] std::string hex() const {
+        return std::format( "{:016x}{:016x}", static_cast<std::uint64_t>( state >> 64 ),
+                            static_cast<std::uint64_t>( state ) );
+    }
+
+  private:
+    Hash& add_size( size_t size ) { return add( static_cast<std::uint64_t>( size ) ); }
+
+    static constexpr unsigned __int128 prime = ( static_cast<unsigned __int128>( 1 ) << 88 ) + 0x13b;
+    unsigned __int128 state = ( static_cast<unsigned __int128>( 0x6c62272e07bb0142 ) << 64 ) + 0x62b821756295c58d;
+};
@@ -0,0 +1,105 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "includeCache.h"
+
+#include "exception.h"
+#include "lexer.h"
+#include "mappedFile.h"
+
+namespace {
+
+bool is_directive( std::vector<LexedFile::Entry> const& tokens, size_t i, std::string_view name ) {
+    return i + 1 < tokens.size() && tokens[ i ].line_start && tokens[ i ].token.tok == TokenType::HASH &&
+           !tokens[ i + 1 ].line_start && spelling( tokens[ i + 1 ].token ) == name;
+}
+
+// The file is guarded if it starts with #ifndef X / #define X, the #ifndef has no #else or #elif, and its #endif
+// ends the file.
+std::optional<std::string> include_guard( std::vector<LexedFile::Entry> const& tokens ) {
+    if ( !is_directive( tokens, 0, "ifndef" ) || tokens.size() < 6 || tokens[ 2 ].token.tok != TokenType::IDENTIFIER ||
+         !is_directive( tokens, 3, "define" ) || tokens[ 5 ].token.tok != TokenType::IDENTIFIER ||
+         tokens[ 5 ].token.value != tokens[ 2 ].token.value ) {
+        return std::nullopt;
+    }
+    int depth = 0;
+    for ( size_t i = 0; i < tokens.size(); ++i ) {
+        if ( is_directive( tokens, i, "if" ) || is_directive( tokens, i, "ifdef" ) ||
+             is_directive( tokens, i, "ifndef" ) ) {
+            ++depth;
+        } else if ( depth == 1 && ( is_directive( tokens, i, "else" ) || is_directive( tokens, i, "elif" ) ) ) {
+            return std::nullopt; // the file has text when X is defined
+        } else if ( is_directive( tokens, i, "endif" ) && --depth == 0 ) {
+            // Nothing may follow on the lines after the #endif.
+            for ( i += 2; !tokens[ i ].line_start && tokens[ i ].token.tok != TokenType::Eof; ++i ) {}
+            if ( tokens[ i ].token.tok != TokenType::Eof ) {
+                return std::nullopt;
+            }
+            return tokens[ 2 ].token.value;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+LexedFile lex_file( std::string_view const source ) {
+    Lexer     lexer( source );
+    LexedFile file;
+    auto&     tokens = file.tokens;
+    while ( true ) {
+        LexedFile::Entry entry;
+        try {
+            if ( tokens.size() >= 2 && is_directive( tokens, tokens.size() - 2, "include" ) ) {
+                entry.token = { TokenType::HEADER_NAME, lexer.get_location(), lexer.get_header_name() };
+            } else {
+                entry.token = lexer.get_token();
+                entry.line_start = lexer.at_line_start();
+            }
+        } catch ( const LexicalException& e ) {
+            entry.token = { TokenType::Null, e.get_location().value_or( lexer.get_location() ), e.get_message() };
+            lexer.skip_line();
+        }
+        entry.before_paren = lexer.next_char_is( '(' );
+        tokens.push_back( std::move( entry ) );
+        if ( tokens.back().token.tok == TokenType::Eof ) {
+            break;
+        }
+    }
+    file.guard = include_guard( tokens );
+    return file;
+}
+
+std::shared_ptr<LexedFile const> lex_file( std::filesystem::path const& path ) {
+    // Map the file rather than copy it through a stream buffer.
+    MappedFile const file( path );
+    return std::make_shared<LexedFile const>( lex_file( file.text() ) );
+}
+
+std::shared_ptr<LexedFile const> IncludeCache::get( std::filesystem::path const& path ) {
+    auto const key = std::filesystem::weakly_canonical( path ).string();
+    auto const time = std::filesystem::last_write_time( path );
+    auto const size = std::filesystem::file_size( path );
+    {
+        std::lock_guard lock( mutex );
+        if ( auto const found = entries.find( key );
+             found != entries.end() && found->second.time == time && found->second.size == size ) {
+            ++hit_count;
+            return found->second.file;
+        }
+    }
+
+    // Lex without the lock, so that other files can be read at the same time.
+    ++miss_count;
+    auto            file = lex_file( path );
+    std::lock_guard lock( mutex );
+    entries[ key ] = { time, size, file };
+    return file;
+}
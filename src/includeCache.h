@@ -0,0 +1,65 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "token.h"
+
+// A source file lexed for the preprocessor, which reads the tokens of each file from one of these.
+struct LexedFile {
+    struct Entry {
+        Token token;                  // Null for a lexical error, with the message as the value
+        bool  line_start { false };   // first token on its line
+        bool  before_paren { false }; // followed by ( with no space between
+    };
+
+    std::vector<Entry>         tokens; // ends with Eof
+    std::optional<std::string> guard;  // the macro of an #ifndef around the whole file
+};
+
+// Lex all the source. The name after #include is a HEADER_NAME token. A lexical error is kept as a token, and the
+// rest of its line skipped, so that an error in lines which are not compiled is not reported.
+LexedFile lex_file( std::string_view source );
+
+// Read and lex a file. Throws if it cannot be read.
+std::shared_ptr<LexedFile const> lex_file( std::filesystem::path const& path );
+
+// Lexed header files, shared by the compilations of a run or of the compile server. An entry is used while the
+// file's size and modification time are unchanged. Thread safe.
+class IncludeCache {
+  public:
+    std::shared_ptr<LexedFile const> get( std::filesystem::path const& path );
+
+    [[nodiscard]] size_t hits() const { return hit_count; }
+    [[nodiscard]] size_t misses() const { return miss_count; }
+
+  private:
+    struct Entry {
+        std::filesystem::file_time_type  time;
+        std::uintmax_t                   size { 0 };
+        std::shared_ptr<LexedFile const> file;
+    };
+
+    std::mutex                   mutex; // guards entries
+    std::map<std::string, Entry> entries;
+    std::atomic<size_t>          hit_count { 0 };
+    std::atomic<size_t>          miss_count { 0 };
+};
@@ -0,0 +1,73 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "instrument.h"
+
+#include <ctime>
+
+std::chrono::nanoseconds thread_cpu_time() {
+    timespec ts {};
+    clock_gettime( CLOCK_THREAD_CPUTIME_ID, &ts );
+    return std::chrono::seconds( ts.tv_sec ) + std::chrono::nanoseconds( ts.tv_nsec );
+}
+
+namespace {
+thread_local std::string current_role;
+}
+
+void set_thread_role( std::string role ) {
+    current_role = std::move( role );
+}
+
+std::string const& thread_role() {
+    return current_role;
+}
+
+void Instrumentation::add( std::unique_ptr<InstrumentListener> listener ) {
+    listeners.push_back( std::move( listener ) );
+}
+
+void Instrumentation::begin( const std::string_view region, const std::string_view function ) const {
+    for ( auto const& listener : listeners ) {
+        listener->begin( region, function );
+    }
+}
+
+void Instrumentation::end( const std::string_view region, const std::string_view function,
+                           Timing const& timing ) const {
+    for ( auto const& listener : listeners ) {
+        listener->end( region, function, timing );
+    }
+}
+
+void Instrumentation::report() const {
+    for ( auto const& listener : listeners ) {
+        listener->report();
+    }
+}
+
+Region::Region( Instrumentation const* instrument, const std::string_view name, const std::string_view function )
+    : instrument( instrument ), name( name ), function( function ) {
+    if ( instrument == nullptr ) {
+        return;
+    }
+    instrument->begin( name, function );
+    start_wall = std::chrono::steady_clock::now();
+    start_cpu = thread_cpu_time();
+}
+
+Region::~Region() {
+    if ( instrument == nullptr ) {
+        return;
+    }
+    Timing const timing { .wall = std::chrono::steady_clock::now() - start_wall,
+                          .cpu = thread_cpu_time() - start_cpu };
+    instrument->end( name, function, timing );
+}
@@ -0,0 +1,80 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Wall clock and CPU time spent in a region of the compiler.
+struct Timing {
+    std::chrono::nanoseconds wall { 0 };
+    std::chrono::nanoseconds cpu { 0 };
+};
+
+// CPU time used by the calling thread.
+std::chrono::nanoseconds thread_cpu_time();
+
+// What the calling thread is for, such as "compile 2", by which listeners name it. Empty if it has not been set.
+void               set_thread_role( std::string role );
+std::string const& thread_role();
+
+// Receives the regions of the compiler as they begin and end. The region and function names are only valid during
+// the call.
+class InstrumentListener {
+  public:
+    InstrumentListener() = default;
+    virtual ~InstrumentListener() = default;
+
+    virtual void begin( [[maybe_unused]] std::string_view region, [[maybe_unused]] std::string_view function ) {}
+    virtual void end( [[maybe_unused]] std::string_view region, [[maybe_unused]] std::string_view function,
+                      [[maybe_unused]] Timing const& timing ) {}
+
+    // Called once the compilation is finished.
+    virtual void report() {};
+};
+
+// Collects the listeners for the instrumentation of the compiler: stages, passes, and functions in passes.
+class Instrumentation {
+  public:
+    Instrumentation() = default;
+    ~Instrumentation() = default;
+
+    void add( std::unique_ptr<InstrumentListener> listener );
+
+    void begin( std::string_view region, std::string_view function ) const;
+    void end( std::string_view region, std::string_view function, Timing const& timing ) const;
+    void report() const;
+
+    [[nodiscard]] bool empty() const { return listeners.empty(); }
+
+  private:
+    std::vector<std::unique_ptr<InstrumentListener>> listeners;
+};
+
+// Times a region while it is in scope. Does nothing if there is no instrumentation, so can be left in place.
+class Region {
+  public:
+    Region( Instrumentation const* instrument, std::string_view name, std::string_view function = {} );
+    ~Region();
+
+    Region( Region const& ) = delete;
+    Region& operator=( Region const& ) = delete;
+
+  private:
+    Instrumentation const*                instrument;
+    std::string_view                      name;
+    std::string_view                      function;
+    std::chrono::steady_clock::time_point start_wall;
+    std::chrono::nanoseconds              start_cpu { 0 };
+};
@@ -0,0 +1,140 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "jobServer.h"
+
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <format>
+#include <optional>
+#include <ranges>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace {
+
+// The fd is open, as make closes them for commands which are not marked as running make.
+bool is_open( int const fd ) {
+    return fd >= 0 && ::fcntl( fd, F_GETFD ) >= 0;
+}
+
+std::optional<int> parse_fd( std::string_view const text ) {
+    int  fd = -1;
+    auto result = std::from_chars( text.data(), text.data() + text.size(), fd );
+    if ( result.ec != std::errc {} || result.ptr != text.data() + text.size() ) {
+        return std::nullopt;
+    }
+    return fd;
+}
+
+} // namespace
+
+JobServer::JobServer( int const read_fd, int const write_fd ) : read_fd( read_fd ), write_fd( write_fd ) {}
+
+JobServer::~JobServer() {
+    while ( !tokens.empty() ) {
+        release();
+    }
+    ::close( read_fd );
+    if ( write_fd != read_fd ) {
+        ::close( write_fd );
+    }
+}
+
+std::unique_ptr<JobServer> JobServer::from_makeflags( std::string_view const makeflags ) {
+    // The last one is used, as make adds its own after any from the user.
+    std::string_view auth;
+    for ( auto const word : std::views::split( makeflags, ' ' ) ) {
+        std::string_view const flag( word.begin(), word.end() );
+        for ( auto const prefix : { "--jobserver-auth=", "--jobserver-fds=" } ) {
+            if ( flag.starts_with( prefix ) ) {
+                auth = flag.substr( std::string_view( prefix ).size() );
+            }
+        }
+    }
+    if ( auth.empty() ) {
+        return nullptr;
+    }
+
+    if ( auth.starts_with( "fifo:" ) ) {
+        std::string const path( auth.substr( 5 ) );
+        int const         fd = ::open( path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC );
+        if ( fd < 0 ) {
+            return nullptr;
+        }
+        return std::unique_ptr<JobServer>( new JobServer( fd, fd ) );
+    }
+
+    auto const comma = auth.find( ',' );
+    if ( comma == std::string_view::npos ) {
+        return nullptr;
+    }
+    auto const read_fd = parse_fd( auth.substr( 0, comma ) );
+    auto const write_fd = parse_fd( auth.substr( comma + 1 ) );
+    if ( !read_fd || !write_fd || !is_open( *read_fd ) || !is_open( *write_fd ) ) {
+        return nullptr;
+    }
+
+    // Read the pipe through a file description of our own, so it can be non-blocking without changing make's. Without
+    // one the jobserver is not used, as a blocking read could wait for ever on a token another process took.
+    for ( auto const* const directory : { "/proc/self/fd", "/dev/fd" } ) {
+        int const fd = ::open( std::format( "{}/{}", directory, *read_fd ).c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC );
+        if ( fd < 0 ) {
+            continue;
+        }
+        // Some systems open /dev/fd/N as a dup of N, sharing make's file description and ignoring O_NONBLOCK.
+        if ( ( ::fcntl( fd, F_GETFL ) & O_NONBLOCK ) == 0 ) {
+            ::close( fd );
+            continue;
+        }
+        if ( int const write = ::fcntl( *write_fd, F_DUPFD_CLOEXEC, 0 ); write >= 0 ) {
+            return std::unique_ptr<JobServer>( new JobServer( fd, write ) );
+        }
+        ::close( fd );
+        return nullptr;
+    }
+    return nullptr;
+}
+
+std::unique_ptr<JobServer> JobServer::from_environment() {
+    auto const* makeflags = std::getenv( "MAKEFLAGS" );
+    return makeflags ? from_makeflags( makeflags ) : nullptr;
+}
+
+bool JobServer::acquire( std::chrono::milliseconds const timeout ) {
+    pollfd ready { .fd = read_fd, .events = POLLIN, .revents = 0 };
+    if ( ::poll( &ready, 1, static_cast<int>( timeout.count() ) ) <= 0 ) {
+        return false;
+    }
+    // Another process may have taken the token since the poll, and the read fails rather than waiting for the next.
+    char token = 0;
+    if ( ::read( read_fd, &token, 1 ) != 1 ) {
+        return false;
+    }
+    std::lock_guard lock( mutex );
+    tokens.push_back( token );
+    return true;
+}
+
+void JobServer::release() {
+    char token = '+';
+    {
+        std::lock_guard lock( mutex );
+        if ( tokens.empty() ) {
+            return;
+        }
+        token = tokens.back();
+        tokens.pop_back();
+    }
+    while ( ::write( write_fd, &token, 1 ) < 0 && errno == EINTR ) {}
+}
@@ -0,0 +1,50 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A client of the GNU make jobserver. Make passes the build's job slots to its children as tokens, one byte each, in
+// a pipe or a named fifo given in MAKEFLAGS. Every process has one slot without a token; each further thread it runs
+// takes a token first and gives it back when it is done, so a build with make -jN runs at most N jobs in total.
+class JobServer {
+  public:
+    ~JobServer();
+
+    JobServer( JobServer const& ) = delete;
+    JobServer& operator=( JobServer const& ) = delete;
+
+    // The jobserver of MAKEFLAGS, --jobserver-auth=R,W (or --jobserver-fds=R,W) for a pipe and
+    // --jobserver-auth=fifo:PATH for a fifo. Null if there is none, or it can't be used.
+    static std::unique_ptr<JobServer> from_makeflags( std::string_view makeflags );
+    static std::unique_ptr<JobServer> from_environment();
+
+    // Take a token, waiting up to timeout for one. Returns false if there was none.
+    bool acquire( std::chrono::milliseconds timeout );
+
+    // Give back a token taken by acquire.
+    void release();
+
+  private:
+    // Takes the fds, opened for it, which are closed with it.
+    JobServer( int read_fd, int write_fd );
+
+    int read_fd; // non-blocking
+    int write_fd;
+
+    std::mutex        mutex; // guards tokens
+    std::vector<char> tokens; // taken, to give back the same bytes
+};
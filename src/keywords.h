@@ -0,0 +1,81 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <string_view>
+
+#include "token.h"
+
+// The keywords, found with a perfect hash of the length and the first and last characters, built when compiling. A
+// word is a keyword if the one entry at its hash is that word, so recognising a word costs one comparison.
+namespace keywords {
+
+struct Keyword {
+    std::string_view name;
+    TokenType        tok { TokenType::IDENTIFIER };
+};
+
+constexpr std::array<Keyword, 17> list { { { "int", TokenType::INT },
+                                           { "return", TokenType::RETURN },
+                                           { "void", TokenType::VOID },
+                                           { "if", TokenType::IF },
+                                           { "else", TokenType::ELSE },
+                                           { "goto", TokenType::GOTO },
+                                           { "break", TokenType::BREAK },
+                                           { "continue", TokenType::CONTINUE },
+                                           { "for", TokenType::FOR },
+                                           { "while", TokenType::WHILE },
+                                           { "do", TokenType::DO },
+                                           { "switch", TokenType::SWITCH },
+                                           { "case", TokenType::CASE },
+                                           { "default", TokenType::DEFAULT },
+                                           { "extern", TokenType::EXTERN },
+                                           { "static", TokenType::STATIC },
+                                           { "long", TokenType::LONG } } };
+
+constexpr size_t table_size = 64;
+
+constexpr size_t hash( std::string_view const word ) {
+    return ( word.size() + static_cast<unsigned char>( word.front() ) +
+             3 * static_cast<unsigned char>( word.back() ) ) %
+           table_size;
+}
+
+// Fails to compile if two keywords have the same hash.
+constexpr auto table = [] {
+    std::array<Keyword, table_size> result {};
+    for ( auto const& keyword : list ) {
+        auto& entry = result[ hash( keyword.name ) ];
+        if ( !entry.name.empty() ) {
+            throw "keywords::hash is not perfect";
+        }
+        entry = keyword;
+    }
+    return result;
+}();
+
+constexpr size_t min_length = 2;
+constexpr size_t max_length = 8;
+
+} // namespace keywords
+
+// The keyword token for the word, or IDENTIFIER if it is not a keyword.
+constexpr TokenType keyword( std::string_view const word ) {
+    if ( word.size() < keywords::min_length || word.size() > keywords::max_length ) {
+        return TokenType::IDENTIFIER;
+    }
+    auto const& entry = keywords::table[ keywords::hash( word ) ];
+    return entry.name == word ? entry.tok : TokenType::IDENTIFIER;
+}
+
+static_assert( keyword( "continue" ) == TokenType::CONTINUE );
+static_assert( keyword( "in" ) == TokenType::IDENTIFIER );
@@ -10,33 +10,26 @@
 
 #include "lexer.h"
 
-#include <map>
-#include <sstream>
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <format>
+#include <iterator>
+#include <stdexcept>
 #include <string>
 
 #include "exception.h"
+#include "keywords.h"
+#include "operators.h"
 
-const std::map<std::string, TokenType> keywords = {
-    //
-    { "int", TokenType::INT },       { "return", TokenType::RETURN },
-    { "void", TokenType::VOID },     { "if", TokenType::IF },
-    { "else", TokenType::ELSE },     { "goto", TokenType::GOTO },
-    { "break", TokenType::BREAK },   { "continue", TokenType::CONTINUE },
-    { "for", TokenType::FOR },       { "while", TokenType::WHILE },
-    { "do", TokenType::DO },         { "switch", TokenType::SWITCH },
-    { "case", TokenType::CASE },     { "default", TokenType::DEFAULT },
-    { "extern", TokenType::EXTERN }, { "static", TokenType::STATIC },
-    { "long", TokenType::LONG } };
+Lexer::Lexer( std::string_view const text ) : ptr( text.data() ), end( text.data() + text.size() ) {};
 
-Lexer::Lexer( std::istream const& s ) {
-    std::stringstream buffer;
-    buffer << s.rdbuf();
-    file = buffer.str();
-    ptr = file.begin();
-};
+Lexer::Lexer( std::istream const& s )
+    : source( std::istreambuf_iterator<char>( s.rdbuf() ), std::istreambuf_iterator<char>() ), ptr( source.data() ),
+      end( source.data() + source.size() ) {};
 
 char Lexer::peek() {
-    if ( ptr == file.end() ) {
+    if ( ptr == end ) {
         return -1;
     }
     return *ptr;
@@ -44,254 +37,200 @@ char Lexer::peek() {
 
 char Lexer::get() {
     while ( true ) {
-        if ( ptr == file.end() ) {
+        if ( ptr == end ) {
             return -1;
         }
         char c = *ptr;
         if ( c == ' ' || c == '\t' || c == '\r' ) {
-            ++ptr;
-            ++pos;
+            advance( scanner.skip_blanks( ptr, end ) );
             continue;
         }
         if ( c == '\n' ) {
             ++ptr;
             ++line;
             pos = 0;
+            newline = true;
+            continue;
+        }
+        if ( c == '\\' && ptr + 1 != end && *( ptr + 1 ) == '\n' ) {
+            // line continuation
+            ptr += 2;
+            ++line;
+            pos = 0;
             continue;
         }
-        if ( c == '/' ) {
+        if ( c == '/' && ptr + 1 != end ) {
             c = *( ptr + 1 );
             if ( c == '/' ) {
                 // // comments
-                ++ptr;
-                while ( c = *( ptr ), c != '\n' ) {
-                    ++ptr;
-                }
+                advance( scanner.find_newline( ptr + 2, end ) );
                 continue;
             }
             if ( c == '*' ) {
                 // /* comments */
-                ++ptr;
-                do {
-                    c = *ptr;
-                    if ( c == '*' && *( ptr + 1 ) == '/' ) {
-                        ptr += 2;
-                        break;
-                    }
-                    ++ptr;
-                } while ( true );
+                auto const comment_end = scanner.find_comment_end( ptr + 2, end );
+                if ( comment_end == end ) {
+                    throw LexicalException( get_location(), "Unterminated comment" );
+                }
+                // The comment may run over lines, and the column goes on from the last of them.
+                if ( auto const lines = scanner.count_newlines( ptr + 2, comment_end ); lines > 0 ) {
+                    line += lines;
+                    pos = 0;
+                    newline = true;
+                    ptr = std::find( std::make_reverse_iterator( comment_end ), std::make_reverse_iterator( ptr ), '\n' )
+                              .base();
+                }
+                advance( comment_end + 2 );
                 continue;
             }
             // otherwise return /
             ++ptr;
+            ++pos;
             return '/';
         }
         ++ptr;
+        ++pos;
         return c;
     };
 }
 
-Token Lexer::get_identifier( const char c ) {
-    std::string identifier( 1, c );
-    char        x = peek();
-    while ( std::isalnum( x ) || x == '_' ) {
-        get();
-        identifier.push_back( x );
-        x = peek();
-    }
+// Moves past the characters from ptr up to next, all on the current line.
+void Lexer::advance( char const* next ) {
+    pos += next - ptr;
+    ptr = next;
+}
+
+// The first character has been read by get(), and the token starts at location. The text is taken from the source
+// rather than built a character at a time.
+Token Lexer::get_identifier( Location const location ) {
+    auto const start = ptr - 1;
+    advance( scanner.skip_identifier( ptr, end ) );
+    std::string_view const identifier( start, ptr );
 
-    if ( keywords.contains( identifier ) ) {
-        return { keywords.at( identifier ), get_location() };
+    if ( auto const tok = keyword( identifier ); tok != TokenType::IDENTIFIER ) {
+        return { tok, location };
     }
-    return { TokenType::IDENTIFIER, get_location(), identifier };
+    return { TokenType::IDENTIFIER, location, std::string( identifier ) };
 }
 
-Token Lexer::get_number( const char c ) {
-    std::string number( 1, c );
+Token Lexer::get_number( Location const location ) {
+    auto const start = ptr - 1;
+    advance( scanner.skip_digits( ptr, end ) );
+    std::string_view const digits( start, ptr );
 
+    auto type = TokenType::CONSTANT;
     char x = peek();
-    while ( std::isdigit( x ) ) {
+    if ( std::isalpha( x ) ) {
+        if ( x != 'l' && x != 'L' ) {
+            throw LexicalException( get_location(), "Invalid digit {:c} in number '{:s}'", x, digits );
+        }
         get();
-        number.push_back( x );
         x = peek();
-    }
-    if ( std::isalpha( x ) ) {
         if ( x == 'l' || x == 'L' ) {
-            get();
-            x = peek();
-            if ( x == 'l' || x == 'L' ) {
-                throw LexicalException( get_location(), "Invalid number of `{:c}` in long literal '{:s}'", x );
-            }
-            return { TokenType::LONGLITERAL, get_location(), number };
+            throw LexicalException( get_location(), "Invalid number of `{:c}` in long literal '{:s}'", x, digits );
         }
-        throw LexicalException( get_location(), "Invalid digit {:c} in number '{:s}'", x, number );
+        type = TokenType::LONGLITERAL;
+    }
+
+    std::uint64_t number { 0 };
+    if ( auto [ _, ec ] = std::from_chars( digits.data(), digits.data() + digits.size(), number ); ec != std::errc() ) {
+        throw LexicalException( get_location(), "Constant '{:s}' is too large", digits );
     }
-    return { TokenType::CONSTANT, get_location(), number };
+    return { type, location, std::string( digits ), number };
 }
 
 Token Lexer::make_token() {
     char const c = get();
-    switch ( c ) {
-    case -1 :
+    first_on_line = newline;
+    newline = false;
+    if ( c == -1 ) {
         return { TokenType::Eof, get_location() };
-    case '(' :
-        return { TokenType::L_PAREN, get_location() };
-    case ')' :
-        return { TokenType::R_PAREN, get_location() };
-    case '{' :
-        return { TokenType::L_BRACE, get_location() };
-    case '}' :
-        return { TokenType::R_BRACE, get_location() };
-    case ';' :
-        return { TokenType::SEMICOLON, get_location() };
-    case '+' : {
-        if ( peek() == '+' ) {
-            get();
-            return { TokenType::INCREMENT, get_location() };
-        }
-        if ( peek() == '=' ) {
-            get();
-            return { TokenType::COMPOUND_PLUS, get_location() };
-        }
-        return { TokenType::PLUS, get_location() };
-    }
-    case '-' :
-        if ( peek() == '-' ) {
-            get();
-            return { TokenType::DECREMENT, get_location() };
-        }
-        if ( peek() == '=' ) {
-            get();
-            return { TokenType::COMPOUND_MINUS, get_location() };
-        }
-        return { TokenType::DASH, get_location() };
-    case '*' : {
-        if ( peek() == '=' ) {
-            get();
-            return { TokenType::COMPOUND_ASTERIX, get_location() };
-        }
-        return { TokenType::ASTÉRIX, get_location() };
-    }
-    case '%' :
-        if ( peek() == '=' ) {
-            get();
-            return { TokenType::COMPOUND_PERCENT, get_location() };
-        }
-        return { TokenType::PERCENT, get_location() };
-    case '/' : {
-        if ( peek() == '=' ) {
-            get();
-            return { TokenType::COMPOUND_SLASH, get_location() };
-        }
-        return { TokenType::SLASH, get_location() };
-    }
-    case '~' :
-        return { TokenType::TILDE, get_location() };
-    case '&' :
-        if ( peek() == '&' ) {
-            get();
-            return { TokenType::LOGICAL_AND, get_location() };
-        }
-        if ( peek() == '=' ) {
-            get();
-            return { TokenType::COMPOUND_AND, get_location() };
-        }
-        return { TokenType::AMPERSAND, get_location() };
-    case '|' :
-        if ( peek() == '|' ) {
-            get();
-            return { TokenType::LOGICAL_OR, get_location() };
-        }
-        if ( peek() == '=' ) {
-            get();
-            return { TokenType::COMPOUND_OR, get_location() };
-        }
-        return { TokenType::PIPE, get_location() };
-    case '^' : {
-        if ( peek() == '=' ) {
-            get();
-            return { TokenType::COMPOUND_XOR, get_location() };
-        }
-        return { TokenType::CARET, get_location() };
     }
-    case '!' :
-        if ( peek() == '=' ) {
-            get();
-            return { TokenType::COMPARISON_NOT, get_location() };
-        }
-        return { TokenType::EXCLAMATION, get_location() };
-    case '<' :
-        if ( peek() == '<' ) {
-            get();
-            if ( peek() == '=' ) {
-                get();
-                return { TokenType::COMPOUND_LEFT_SHIFT, get_location() };
+    Location const location { line, pos }; // the column of c
+
+    // Operators: run the DFA from the first character while the next one continues the operator.
+    auto const& dfa = operators::dfa;
+    if ( auto state = dfa.next[ 0 ][ dfa.char_class[ static_cast<unsigned char>( c ) ] ]; state != 0 ) {
+        while ( ptr != end ) {
+            auto const next = dfa.next[ state ][ dfa.char_class[ static_cast<unsigned char>( *ptr ) ] ];
+            if ( next == 0 ) {
+                break;
             }
-            return { TokenType::LEFT_SHIFT, get_location() };
+            state = next;
+            advance( ptr + 1 );
         }
-        if ( peek() == '=' ) {
-            get();
-            return { TokenType::LESS_EQUALS, get_location() };
-        }
-        return { TokenType::LESS, get_location() };
-    case '>' :
-        if ( peek() == '>' ) {
-            get();
-            if ( peek() == '=' ) {
-                get();
-                return { TokenType::COMPOUND_RIGHT_SHIFT, get_location() };
-            }
-            return { TokenType::RIGHT_SHIFT, get_location() };
-        }
-        if ( peek() == '=' ) {
-            get();
-            return { TokenType::GREATER_EQUALS, get_location() };
-        }
-        return { TokenType::GREATER, get_location() };
-    case '=' : {
-        if ( peek() == '=' ) {
-            get();
-            return { TokenType::COMPARISON_EQUALS, get_location() };
-        }
-        return { TokenType::EQUALS, get_location() };
+        return { dfa.accept[ state ], location };
     }
-    case '?' :
-        return { TokenType::QUESTION, get_location() };
-    case ':' :
-        return { TokenType::COLON, get_location() };
-    case ',' :
-        return { TokenType::COMMA, get_location() };
-    default :;
-    };
+
     if ( std::isdigit( c ) ) {
-        return get_number( c );
+        return get_number( location );
     }
     if ( std::isalpha( c ) or c == '_' ) {
-        return get_identifier( c );
+        return get_identifier( location );
     }
     throw LexicalException( get_location(), "Unknown character '{:c}'", c );
 }
 
-Token Lexer::get_token() {
-    if ( !next_token.empty() ) {
-        auto t = next_token.front();
-        next_token.pop_front();
-        return t;
+Token TokenStream::get_token() {
+    if ( count == 0 ) {
+        return make_token();
     }
+    auto token = std::move( lookahead[ first ] );
+    first = ( first + 1 ) % max_lookahead;
+    --count;
+    return token;
+}
+
+TokenBuffer::TokenBuffer( TokenStream& stream ) {
+    do {
+        buffer.push_back( stream.get_token() );
+    } while ( buffer.back().tok != TokenType::Eof );
+}
 
-    auto token = make_token();
+Token TokenBuffer::make_token() {
+    auto const& token = buffer[ next ];
+    if ( next + 1 < buffer.size() ) {
+        ++next; // Eof is returned for ever
+    }
+    last_location = token.location;
     return token;
 }
 
-Token const& Lexer::peek_token( size_t offset ) {
-    while ( offset >= next_token.size() ) {
-        auto t = make_token();
-        next_token.push_back( t );
+Token const& TokenStream::peek_token( size_t offset ) {
+    static_assert( std::has_single_bit( max_lookahead ) );
+    if ( offset >= max_lookahead ) {
+        throw std::out_of_range( std::format( "Cannot look {} tokens ahead", offset + 1 ) );
+    }
+    for ( ; count <= offset; ++count ) {
+        lookahead[ ( first + count ) % max_lookahead ] = make_token();
+    }
+    return lookahead[ ( first + offset ) % max_lookahead ];
+}
+
+void Lexer::skip_line() {
+    ptr = scanner.find_newline( ptr, end );
+}
+
+std::string Lexer::get_header_name() {
+    while ( ptr != end && ( *ptr == ' ' || *ptr == '\t' ) ) {
+        ++ptr;
+        ++pos;
+    }
+    if ( ptr == end || ( *ptr != '"' && *ptr != '<' ) ) {
+        throw LexicalException( get_location(), "Expected \"file\" or <file>" );
+    }
+    char const close = *ptr == '"' ? '"' : '>';
+    auto const start = ptr;
+    for ( ++ptr; ptr != end && *ptr != close; ++ptr ) {
+        if ( *ptr == '\n' ) {
+            break;
+        }
     }
-    if ( next_token.size() > offset ) {
-        return next_token.at( offset );
+    if ( ptr == end || *ptr != close ) {
+        throw LexicalException( get_location(), "Unterminated file name" );
     }
-    auto t = get_token();
-    next_token.push_back( t );
-    return next_token.front();
+    ++ptr;
+    std::string name( start, ptr );
+    pos += name.size();
+    return name;
 }
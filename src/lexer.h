@@ -10,34 +10,99 @@
 
 #pragma once
 
-#include <deque>
+#include <array>
 #include <istream>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "scan.h"
 #include "token.h"
 
-class Lexer {
+// The tokens read by the parser, with lookahead. The tokens looked ahead at are kept in a ring of fixed size, and are
+// moved in and out of it rather than copied.
+class TokenStream {
   public:
-    explicit Lexer( std::istream const& s );
-    ~Lexer() = default;
+    // The most tokens which can be looked ahead at, a power of 2.
+    static constexpr size_t max_lookahead = 4;
+
+    virtual ~TokenStream() = default;
 
-    Token        get_token();
+    Token get_token();
+    // The token offset tokens on from the next one, which stays in place until get_token reads it. Throws
+    // std::out_of_range if offset is max_lookahead or more.
     Token const& peek_token( size_t offset = 0 );
 
-    [[nodiscard]] Location get_location() const { return { line, pos + 1 }; };
+    [[nodiscard]] virtual Location get_location() const = 0;
+
+  protected:
+    virtual Token make_token() = 0;
+
+  private:
+    std::array<Token, max_lookahead> lookahead;
+    size_t                           first { 0 }; // index in lookahead of the next token
+    size_t                           count { 0 }; // tokens in lookahead
+};
+
+// All the tokens of a stream, read before parsing and then given to the parser.
+class TokenBuffer : public TokenStream {
+  public:
+    // Reads the stream up to and including the Eof.
+    explicit TokenBuffer( TokenStream& stream );
+    ~TokenBuffer() override = default;
+
+    [[nodiscard]] Location                  get_location() const override { return last_location; }
+    [[nodiscard]] std::vector<Token> const& tokens() const { return buffer; }
+
+  protected:
+    Token make_token() override;
+
+  private:
+    std::vector<Token> buffer;
+    size_t             next { 0 };
+    Location           last_location { 1, 1 };
+};
+
+class Lexer : public TokenStream {
+  public:
+    // Lexes the text in place, so it must outlive the lexer.
+    explicit Lexer( std::string_view text );
+    // Reads the stream into the lexer.
+    explicit Lexer( std::istream const& s );
+    Lexer( Lexer const& ) = delete;
+    Lexer& operator=( Lexer const& ) = delete;
+    ~Lexer() override = default;
+
+    [[nodiscard]] Location get_location() const override { return { line, pos + 1 }; };
+
+    // For the preprocessor, which reads the tokens without lookahead.
+
+    // The last token read was the first on its line.
+    [[nodiscard]] bool at_line_start() const { return first_on_line; }
+    // Skip the rest of the line, after a lexical error.
+    void skip_line();
+    // The next character, without skipping blanks.
+    [[nodiscard]] bool next_char_is( char c ) const { return ptr != end && *ptr == c; }
+    // The "file" or <file> of an #include, with its delimiters.
+    std::string get_header_name();
+
+  protected:
+    Token make_token() override;
 
   private:
     char get();
     char peek();
 
-    Token get_identifier( char c );
-    Token get_number( char c );
-    Token make_token();
-
-    std::string           file;
-    std::string::iterator ptr;
-    size_t                line { 1 };
-    size_t                pos { 1 };
+    void  advance( char const* next );
+    Token get_identifier( Location location );
+    Token get_number( Location location );
 
-    std::deque<Token> next_token;
+    std::string          source; // read from a stream
+    char const*          ptr;
+    char const*          end;
+    scan::Scanner const& scanner { scan::best() };
+    size_t               line { 1 };
+    size_t               pos { 0 }; // characters read on the line
+    bool                 newline { true };
+    bool                 first_on_line { true };
 };
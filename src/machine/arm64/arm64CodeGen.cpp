@@ -10,59 +10,52 @@
 
 #include "arm64CodeGen.h"
 
-#include <print>
-
 #include <spdlog/spdlog.h>
 
 #include "arm64_at/includes.h"
 #include "armAssemblyGen.h"
 #include "common.h"
+#include "dump.h"
 #include "exception.h"
 #include "filterPseudoARM.h"
 #include "fixInstructARM.h"
+#include "instrument.h"
 #include "printerARM64.h"
 
-Arm64CodeGen::Arm64CodeGen( Option const& option, SymbolTable& symbol_table ) : CodeGenerator( option, symbol_table ) {
+Arm64CodeGen::Arm64CodeGen( CompilationContext& context ) : CodeGenerator( context ) {
     comment_prefix = "// ";
     x12 = std::make_shared<arm64_at::Register_>( Location(), arm64_at::RegisterName::X12 );
 }
 
 CodeGenBase Arm64CodeGen::run_codegen( tac::Program tac ) {
-    spdlog::info( "Run codegen," );
-    ARMAssemblyGen assembler;
-    auto           assembly = assembler.generate( tac );
-    PrinterARM64   assemblerPrinter;
-    auto           output = assemblerPrinter.print( assembly );
-    std::println( "Assembly Output: {}", to_string( option.machine ) );
-    std::println( "------------------------" );
-    std::println( "{:s}", output );
-
-    spdlog::info( "Filtered 1: Filter Pseudo" );
-    FilterPseudoARM filter;
-    filter.filter( assembly );
-    output = assemblerPrinter.print( assembly );
-    std::println( "Filtered 1:" );
-    std::println( "----------" );
-    std::println( "{:s}", output );
-
-    spdlog::info( "Filtered 2: Fix Instructions" );
-    FixInstructARM filter2;
-    filter2.filter( assembly );
-    output = assemblerPrinter.print( assembly );
-    std::println( "Filtered 2:" );
-    std::println( "----------" );
-    std::println( "{:s}", output );
+    context.logger->info( "Run codegen," );
+    arm64_at::Program assembly;
+    {
+        Region         region( option.instrument, "asmgen" );
+        ARMAssemblyGen assembler;
+        assembly = assembler.generate( tac );
+    }
+    PrinterARM64 assemblerPrinter;
+    if ( option.dump_asm & AsmDump::AsmGen ) {
+        dump( option, std::format( "Assembly Output {}", to_string( option.machine ) ),
+              assemblerPrinter.print( assembly ) );
+    }
 
-    return std::static_pointer_cast<CodeGenBase_>( assembly );
-}
+    PassManager<arm64_at::Program> passes;
+    passes.add( std::make_unique<FilterPseudoARM>() );
+    passes.add( std::make_unique<FixInstructARM>() );
+    passes.set_instrumentation( option.instrument );
+    passes.set_logger( context.logger.get() );
+    passes.add_hook( [ this, &assemblerPrinter ]( std::string_view pass, arm64_at::Program program ) {
+        if ( pass == "arm64-pseudo" && option.dump_asm & AsmDump::AsmPseudo ) {
+            dump( option, "Filtered 1", assemblerPrinter.print( program ) );
+        } else if ( pass == "arm64-fix" && option.dump_asm & AsmDump::AsmFix ) {
+            dump( option, "Filtered 2", assemblerPrinter.print( program ) );
+        }
+    } );
+    passes.run( assembly );
 
-void Arm64CodeGen::generate_output_file( const CodeGenBase assembly ) {
-    spdlog::info( "Generate output file for {}.", to_string( option.machine ) );
-    // Generate Assembly code
-    generate( assembly );
-    std::println( "{} Assembly:", to_string( option.machine ) );
-    std::println( "---------------" );
-    std::println( "{:s}", get_output() );
+    return std::static_pointer_cast<CodeGenBase_>( assembly );
 }
 
 void Arm64CodeGen::generate( const CodeGenBase program ) {
@@ -70,13 +63,6 @@ void Arm64CodeGen::generate( const CodeGenBase program ) {
     if ( !arm64_program ) {
         throw CodeException( Location {}, "Invalid program type for ARM64 code generation" );
     }
-    make_output_file_name();
-
-    file.open( output, std::ios::out );
-    if ( !file.is_open() ) {
-        throw CodeException( arm64_program->location, "Cannot open file {}", output.string() );
-    }
-
     arm64_program->accept( this );
 }
 
@@ -87,8 +73,6 @@ void Arm64CodeGen::visit_Program( const arm64_at::Program ast ) {
     add_line( "\t.text" );
 
     ast->function->accept( this );
-
-    file.close();
 }
 
 void Arm64CodeGen::visit_FunctionDef( const arm64_at::FunctionDef ast ) {
@@ -16,13 +16,12 @@
 
 class Arm64CodeGen : public CodeGenerator, public arm64_at::Visitor<void> {
   public:
-    Arm64CodeGen( Option const& option, SymbolTable& symbol_table );
+    explicit Arm64CodeGen( CompilationContext& context );
     ~Arm64CodeGen() override = default;
 
     void generate( CodeGenBase program ) override;
 
     CodeGenBase run_codegen( tac::Program tac ) override;
-    void        generate_output_file( CodeGenBase assembly ) override;
 
     void visit_Program( arm64_at::Program ast ) override;
     void visit_FunctionDef( arm64_at::FunctionDef ast ) override;
@@ -15,16 +15,16 @@
 #include "arm64_at/includes.h"
 #include "common.h"
 
-void FilterPseudoARM::filter( arm64_at::Program program ) {
-    program->accept( this );
+void FilterPseudoARM::run_on_function( const arm64_at::FunctionDef function ) {
+    function->accept( this );
 }
 
 void FilterPseudoARM::visit_Program( const arm64_at::Program ast ) {
-    reset_stack_info();
     ast->function->accept( this );
 }
 
 void FilterPseudoARM::visit_FunctionDef( const arm64_at::FunctionDef ast ) {
+    reset_stack_info();
     for ( auto const& instr : ast->instructions ) {
         std::visit( overloaded { [ this ]( arm64_at::Mov v ) -> void { v->accept( this ); },
                                  [ this ]( arm64_at::Load l ) -> void { l->accept( this ); },
@@ -41,7 +41,7 @@ void FilterPseudoARM::visit_FunctionDef( const arm64_at::FunctionDef ast ) {
                     instr );
     }
     ast->stack_size = get_number_stack_locations();
-    spdlog::debug( "Function {} has {} stack locations", ast->name, get_number_stack_locations() );
+    logger->debug( "Function {} has {} stack locations", ast->name, get_number_stack_locations() );
 }
 
 void FilterPseudoARM::visit_Mov( const arm64_at::Mov ast ) {
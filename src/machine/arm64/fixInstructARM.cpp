@@ -20,8 +20,8 @@ FixInstructARM::FixInstructARM() {
     x11 = std::make_shared<arm64_at::Register_>( Location(), arm64_at::RegisterName::X11 );
 }
 
-void FixInstructARM::filter( arm64_at::Program program ) {
-    program->accept( this );
+void FixInstructARM::run_on_function( const arm64_at::FunctionDef function ) {
+    function->accept( this );
 }
 
 void FixInstructARM::visit_Program( arm64_at::Program ast ) {
@@ -13,14 +13,17 @@
 #include "arm64_at/includes.h"
 #include "arm64_at/visitor.h"
 #include "common.h"
+#include "passManager.h"
 
 #include <vector>
 
-class FixInstructARM : public arm64_at::Visitor<void> {
+class FixInstructARM : public arm64_at::Visitor<void>,
+                       public FunctionPass<arm64_at::Program, arm64_at::FunctionDef> {
   public:
     FixInstructARM();
 
-    void filter( arm64_at::Program program );
+    [[nodiscard]] std::string_view name() const override { return "arm64-fix"; }
+    void                           run_on_function( arm64_at::FunctionDef function ) override;
 
     void visit_Program( arm64_at::Program ast ) override;
     void visit_FunctionDef( arm64_at::FunctionDef ast ) override;
@@ -13,12 +13,13 @@
 #include <map>
 
 #include "common.h"
+#include "instrument.h"
 #include "spdlog/spdlog.h"
 #include "x86_common.h"
 
 #include <complex>
 
-AssemblyGen::AssemblyGen( Option const& option ) : option( option ) {
+AssemblyGen::AssemblyGen( CompilationContext& context ) : option( context.option ), logger( *context.logger ) {
     zero = std::make_shared<x86_at::Imm_>( Location(), 0 );
     ax = std::make_shared<x86_at::Register_>( Location(), x86_at::RegisterName::AX, x86_at::RegisterSize::Long );
     cx = std::make_shared<x86_at::Register_>( Location(), x86_at::RegisterName::CX, x86_at::RegisterSize::Long );
@@ -53,7 +54,8 @@ x86_at::StaticVariable AssemblyGen::staticVariable( tac::StaticVariable atac ) {
 }
 
 x86_at::FunctionDef AssemblyGen::functionDef( const tac::FunctionDef atac ) {
-    spdlog::debug( "functionDef: {}", atac->name );
+    logger.debug( "functionDef: {}", atac->name );
+    Region region( option.instrument, "asmgen", atac->name );
     auto function = mk_node<x86_at::FunctionDef_>( atac );
     function->name = atac->name;
     function->global = atac->global;
@@ -75,7 +77,7 @@ x86_at::FunctionDef AssemblyGen::functionDef( const tac::FunctionDef atac ) {
         }
         count++;
     }
-    spdlog::debug( "Arg Count: {}, Stack count: {}", atac->params.size(), stack_count );
+    logger.debug( "Arg Count: {}, Stack count: {}", atac->params.size(), stack_count );
 
     for ( auto instr : atac->instructions ) {
         std::visit(
@@ -274,7 +276,7 @@ void AssemblyGen::label( const tac::Label atac, std::vector<x86_at::Instruction>
 }
 
 void AssemblyGen::functionCall( const tac::FunCall atac, std::vector<x86_at::Instruction>& instructions ) const {
-    spdlog::debug( "Function call: {}", atac->function_name );
+    logger.debug( "Function call: {}", atac->function_name );
     int arg_count = atac->arguments.size();
 
     int stack_padding = 0;
@@ -285,7 +287,7 @@ void AssemblyGen::functionCall( const tac::FunCall atac, std::vector<x86_at::Ins
             // If odd number of stack arguments, add padding
             stack_padding = 8;
     }
-    spdlog::debug( "Arg count: {}, Stack args: {}, Stack padding: {}", arg_count, stack_args, stack_padding );
+    logger.debug( "Arg count: {}, Stack args: {}, Stack padding: {}", arg_count, stack_args, stack_padding );
 
     // Fix stack alignment
     if ( stack_padding != 0 ) {
@@ -310,7 +312,7 @@ void AssemblyGen::functionCall( const tac::FunCall atac, std::vector<x86_at::Ins
         // If there are more than 6 arguments, we need to push the remaining ones to the stack, in reverse order
         int s = stack_args;
         for ( auto it = atac->arguments.end() - 1; s > 0; --it, --s ) {
-            spdlog::debug( "Stack args: {} ", s );
+            logger.debug( "Stack args: {} ", s );
             auto v = value( *it );
             if ( std::holds_alternative<x86_at::Imm>( v ) || std::holds_alternative<x86_at::Register>( v ) ) {
                 // If the value is an immediate or register, we can push it to the stack
@@ -10,13 +10,14 @@
 
 #pragma once
 
+#include "compilationContext.h"
 #include "tac/includes.h"
 #include "x86_at/includes.h"
 
 /// Convert TAC Abstract tree to AT Assembly tree
 class AssemblyGen {
   public:
-    AssemblyGen( Option const& option );
+    explicit AssemblyGen( CompilationContext& context );
     ~AssemblyGen() = default;
 
     x86_at::Program generate( tac::Program atac );
@@ -47,7 +48,8 @@ class AssemblyGen {
 
     AssemblyType operand_type( tac::Value atac ) const;
 
-    Option const& option;
+    Option const&   option;
+    spdlog::logger& logger;
 
     x86_at::Imm zero;
 
@@ -17,8 +17,8 @@
 
 FilterPseudoX86::FilterPseudoX86( SymbolTable& symbol_table ) : symbol_table( symbol_table ) {}
 
-void FilterPseudoX86::filter( x86_at::Program program ) {
-    program->accept( this );
+void FilterPseudoX86::run_on_function( const x86_at::FunctionDef function ) {
+    function->accept( this );
 }
 
 void FilterPseudoX86::visit_Program( const x86_at::Program ast ) {
@@ -33,7 +33,7 @@ void FilterPseudoX86::visit_FunctionDef( const x86_at::FunctionDef ast ) {
         std::visit( [ this ]( auto&& v ) -> void { v->accept( this ); }, instr );
     }
     ast->stack_size = next_stack_location;
-    spdlog::debug( "Function {} has {} stack locations", ast->name, ast->stack_size );
+    logger->debug( "Function {} has {} stack locations", ast->name, ast->stack_size );
 }
 
 void FilterPseudoX86::visit_Mov( const x86_at::Mov ast ) {
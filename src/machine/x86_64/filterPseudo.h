@@ -12,16 +12,18 @@
 
 #include <map>
 
+#include "passManager.h"
 #include "symbolTable.h"
 #include "x86_at/includes.h"
 #include "x86_at/visitor.h"
 
-class FilterPseudoX86 : public x86_at::Visitor<void> {
+class FilterPseudoX86 : public x86_at::Visitor<void>, public FunctionPass<x86_at::Program, x86_at::FunctionDef> {
   public:
     FilterPseudoX86( SymbolTable& symbol_table );
     ~FilterPseudoX86() override = default;
 
-    void filter( x86_at::Program program );
+    [[nodiscard]] std::string_view name() const override { return "x86-pseudo"; }
+    void                           run_on_function( x86_at::FunctionDef function ) override;
     // int  get_number_stack_locations() const;
 
     void visit_Program( x86_at::Program ast ) override;
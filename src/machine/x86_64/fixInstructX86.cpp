@@ -43,8 +43,8 @@ FixInstructX86::FixInstructX86() {
     sp = std::make_shared<x86_at::Register_>( Location(), x86_at::RegisterName::SP, x86_at::RegisterSize::Qword );
 }
 
-void FixInstructX86::filter( x86_at::Program program ) {
-    program->accept( this );
+void FixInstructX86::run_on_function( const x86_at::FunctionDef function ) {
+    function->accept( this );
 }
 
 void FixInstructX86::visit_Program( const x86_at::Program ast ) {
@@ -56,14 +56,14 @@ void FixInstructX86::visit_Program( const x86_at::Program ast ) {
 void FixInstructX86::visit_FunctionDef( const x86_at::FunctionDef ast ) {
     current_instructions.clear();
 
-    spdlog::debug( "Function: {} - stacksize: {} ", ast->name, ast->stack_size );
+    logger->debug( "Function: {} - stacksize: {} ", ast->name, ast->stack_size );
     // Add Allocate Stack Instruction
     if ( ast->stack_size != 0 ) {
         int size = ast->stack_size;
         size = ( ( size + 15 ) & ~15 ); // Align to 16 bytes
         auto imm = mk_node<x86_at::Imm_>( ast, size );
         auto allocate = mk_node<x86_at::Binary_>( ast, x86_at::BinaryOpType::SUB, AssemblyType::Quadword, imm, sp );
-        spdlog::debug( "Adding AllocateStack instruction: {}", size );
+        logger->debug( "Adding AllocateStack instruction: {}", size );
         ast->instructions.insert( ast->instructions.begin(), allocate );
     }
 
@@ -268,12 +268,12 @@ void FixInstructX86::visit_Cmp( const x86_at::Cmp ast ) {
 }
 
 void FixInstructX86::visit_AllocateStack( const x86_at::AllocateStack ast ) {
-    spdlog::debug( "Adding AllocateStack instruction: {}", ast->size );
+    logger->debug( "Adding AllocateStack instruction: {}", ast->size );
     // Add Allocate Stack Instruction
     if ( ast->size != 0 ) {
         auto allocate = mk_node<x86_at::AllocateStack_>( ast );
         allocate->size = ast->size;
-        spdlog::debug( "Adding AllocateStack instruction {} - {}", ast->size, allocate->size );
+        logger->debug( "Adding AllocateStack instruction {} - {}", ast->size, allocate->size );
         current_instructions.emplace_back( allocate );
     }
 }
@@ -10,15 +10,17 @@
 
 #pragma once
 
+#include "passManager.h"
 #include "x86_at/includes.h"
 #include "x86_at/visitor.h"
 
-class FixInstructX86 : public x86_at::Visitor<void> {
+class FixInstructX86 : public x86_at::Visitor<void>, public FunctionPass<x86_at::Program, x86_at::FunctionDef> {
   public:
     FixInstructX86();
     ~FixInstructX86() override = default;
 
-    void filter( x86_at::Program program );
+    [[nodiscard]] std::string_view name() const override { return "x86-fix"; }
+    void                           run_on_function( x86_at::FunctionDef function ) override;
 
   public:
     void visit_Program( x86_at::Program ast ) override;
@@ -10,12 +10,14 @@
 
 #include "x86_64CodeGen.h"
 
-#include <print>
-
 #include <spdlog/spdlog.h>
 
 #include "common.h"
+#include "compileCache.h"
+#include "dump.h"
 #include "exception.h"
+#include "instrument.h"
+#include "tacHash.h"
 #include "x86_at/includes.h"
 #include "x86_common.h"
 
@@ -87,8 +89,21 @@ std::string assemble_reg( x86_at::Register r ) {
     }
 }
 
-X86_64CodeGen::X86_64CodeGen( Option const& option, SymbolTable& symbol_table )
-    : CodeGenerator( option, symbol_table ) {
+// Add delta to the line numbers in the comments of the text of a function.
+std::string move_lines( std::string_view text, std::string_view marker, std::int64_t const delta ) {
+    std::string result;
+    for ( auto found = text.find( marker ); found != std::string_view::npos; found = text.find( marker ) ) {
+        auto const digits = found + marker.size();
+        auto const end = text.find_first_not_of( "0123456789", digits );
+        auto const line = std::stoll( std::string( text.substr( digits, end - digits ) ) );
+        result += text.substr( 0, digits );
+        result += std::to_string( line + delta );
+        text.remove_prefix( end == std::string_view::npos ? text.size() : end );
+    }
+    return result + std::string( text );
+}
+
+X86_64CodeGen::X86_64CodeGen( CompilationContext& context ) : CodeGenerator( context ) {
     if ( option.system == System::Linux || option.system == System::FreeBSD ) {
         local_prefix = ".L";
     } else if ( option.system == System::MacOS ) {
@@ -97,41 +112,74 @@ X86_64CodeGen::X86_64CodeGen( Option const& option, SymbolTable& symbol_table )
 }
 
 CodeGenBase X86_64CodeGen::run_codegen( tac::Program tac ) {
-    spdlog::info( "Run codegen," );
-    AssemblyGen assembler( option );
-    auto        assembly = assembler.generate( tac );
-    PrinterX86  assemblerPrinter;
-    auto        output = assemblerPrinter.print( assembly );
-    std::println( "Assembly Output: {}", to_string( option.machine ) );
-    std::println( "-----------------------" );
-    std::println( "{:s}", output );
-
-    spdlog::info( "Filtered 1: Filter Pseudo" );
-    FilterPseudoX86 filter( symbol_table );
-    filter.filter( assembly );
-    output = assemblerPrinter.print( assembly );
-    std::println( "Filtered 1:" );
-    std::println( "----------" );
-    std::println( "{:s}", output );
-
-    spdlog::info( "Filtered 2: Fix Instructions" );
-    FixInstructX86 filter2;
-    filter2.filter( assembly );
-    output = assemblerPrinter.print( assembly );
-    std::println( "Filtered 2:" );
-    std::println( "----------" );
-    std::println( "{:s}", output );
+    context.logger->info( "Run codegen," );
+    if ( option.compile_cache && !option.dumping() ) {
+        tac = use_cached_functions( tac );
+    }
+    x86_at::Program assembly;
+    {
+        Region      region( option.instrument, "asmgen" );
+        AssemblyGen assembler( context );
+        assembly = assembler.generate( tac );
+    }
+    PrinterX86 assemblerPrinter;
+    if ( option.dump_asm & AsmDump::AsmGen ) {
+        dump( option, std::format( "Assembly Output {}", to_string( option.machine ) ),
+              assemblerPrinter.print( assembly ) );
+    }
+
+    PassManager<x86_at::Program> passes;
+    passes.add( std::make_unique<FilterPseudoX86>( symbol_table ) );
+    passes.add( std::make_unique<FixInstructX86>() );
+    passes.set_instrumentation( option.instrument );
+    passes.set_logger( context.logger.get() );
+    passes.add_hook( [ this, &assemblerPrinter ]( std::string_view pass, x86_at::Program program ) {
+        if ( pass == "x86-pseudo" && option.dump_asm & AsmDump::AsmPseudo ) {
+            dump( option, "Filtered 1", assemblerPrinter.print( program ) );
+        } else if ( pass == "x86-fix" && option.dump_asm & AsmDump::AsmFix ) {
+            dump( option, "Filtered 2", assemblerPrinter.print( program ) );
+        }
+    } );
+    passes.run( assembly );
     return std::static_pointer_cast<CodeGenBase_>( assembly );
 }
 
-void X86_64CodeGen::generate_output_file( const CodeGenBase assembly ) {
-    spdlog::info( "Generate output file for {}.", to_string( option.machine ) );
-
-    // Generate Assembly code
-    generate( assembly );
-    std::println( "{} Assembly:", to_string( option.machine ) );
-    std::println( "---------------" );
-    std::println( "{:s}", get_output() );
+// A function whose assembly is in the cache is replaced by an empty function, which stands for it in the passes and
+// has the cached text printed for it. The key is the structure of the function's TAC, and the cached text is stored
+// with the line of the function so that the line comments can be moved to where the function now is.
+tac::Program X86_64CodeGen::use_cached_functions( tac::Program const tac ) {
+    Region  region( option.instrument, "function-cache" );
+    TacHash hasher( symbol_table );
+    auto    program = mk_node<tac::Program_>( tac );
+    for ( auto const& item : tac->top_level ) {
+        auto const function = std::get_if<tac::FunctionDef>( &item );
+        if ( !function ) {
+            program->top_level.push_back( item );
+            continue;
+        }
+        auto const& f = *function;
+        auto const  key = Hash {}
+                             .add( compiler_version )
+                             .add( to_string( option.machine ) )
+                             .add( option.system )
+                             .add( hasher.hash( f ) )
+                             .hex();
+        auto       entry = option.compile_cache->get( key );
+        auto const newline = entry ? entry->find( '\n' ) : std::string::npos;
+        if ( newline == std::string::npos ) {
+            function_keys[ f->name ] = key;
+            program->top_level.push_back( item );
+            continue;
+        }
+        context.logger->debug( "Function {} found in the compile cache", f->name );
+        auto const line = std::stoll( entry->substr( 0, newline ) );
+        cached_functions[ f->name ] =
+            move_lines( std::string_view( *entry ).substr( newline + 1 ), comment_prefix + " line ",
+                        static_cast<std::int64_t>( f->location.line ) - line );
+        program->top_level.emplace_back( mk_node<tac::FunctionDef_>( f, f->name, std::vector<std::string> {},
+                                                                     std::vector<tac::Instruction> {}, f->global ) );
+    }
+    return program;
 }
 
 void X86_64CodeGen::generate( const CodeGenBase program ) {
@@ -140,19 +188,11 @@ void X86_64CodeGen::generate( const CodeGenBase program ) {
     if ( !x86_program ) {
         throw CodeException( Location {}, "Invalid program type for x86_64 code generation" );
     }
-    make_output_file_name();
-
-    file.open( output, std::ios::out );
-    if ( !file.is_open() ) {
-        throw CodeException( x86_program->location, "Cannot open file {}", output.string() );
-    }
-
     x86_program->accept( this );
 
     if ( option.system == System::Linux || option.system == System::FreeBSD ) {
         add_line( "\t\t.section .note.GNU-stack,\"\",@progbits" );
     }
-    file.close();
 }
 
 void X86_64CodeGen::visit_Program( const x86_at::Program ast ) {
@@ -165,6 +205,12 @@ void X86_64CodeGen::visit_Program( const x86_at::Program ast ) {
 }
 
 void X86_64CodeGen::visit_FunctionDef( const x86_at::FunctionDef ast ) {
+    if ( auto const cached = cached_functions.find( ast->name ); cached != cached_functions.end() ) {
+        text += cached->second;
+        return;
+    }
+    auto const start = text.size();
+
     current_function = ast;
     std::string name = native_label( ast->name );
     current_function_name = ast->name;
@@ -182,6 +228,11 @@ void X86_64CodeGen::visit_FunctionDef( const x86_at::FunctionDef ast ) {
         std::visit( [ this ]( auto&& v ) -> void { v->accept( this ); }, instr );
     }
     add_line( "" );
+
+    if ( auto const key = function_keys.find( ast->name ); key != function_keys.end() ) {
+        option.compile_cache->put( key->second,
+                                   std::format( "{}\n{}", ast->location.line, std::string_view( text ).substr( start ) ) );
+    }
 }
 
 void X86_64CodeGen::visit_StaticVariable( x86_at::StaticVariable ast ) {
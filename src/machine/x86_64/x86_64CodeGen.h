@@ -10,19 +10,21 @@
 
 #pragma once
 
+#include <map>
+#include <string>
+
 #include "codeGen.h"
 #include "x86_at/includes.h"
 #include "x86_at/visitor.h"
 
 class X86_64CodeGen : public CodeGenerator, public x86_at::Visitor<void> {
   public:
-    X86_64CodeGen( Option const& option, SymbolTable& symbol_table );
+    explicit X86_64CodeGen( CompilationContext& context );
     ~X86_64CodeGen() override = default;
 
     void generate( CodeGenBase program ) override;
 
     CodeGenBase run_codegen( tac::Program tac ) override;
-    void        generate_output_file( CodeGenBase assembly ) override;
 
     void visit_Program( x86_at::Program ast ) override;
     void visit_FunctionDef( x86_at::FunctionDef ast ) override;
@@ -51,6 +53,8 @@ class X86_64CodeGen : public CodeGenerator, public x86_at::Visitor<void> {
     void visit_Data( x86_at::Data ast ) override;
 
   private:
+    tac::Program use_cached_functions( tac::Program tac );
+
     std::string operand( const x86_at::Operand& op );
     std::string native_label( std::string_view name ) const;
     std::string jump_label( std::string_view name );
@@ -60,4 +64,8 @@ class X86_64CodeGen : public CodeGenerator, public x86_at::Visitor<void> {
 
     std::string         current_function_name;
     x86_at::FunctionDef current_function;
+
+    // With option.compile_cache, the assembly of the functions found in it, and the keys of those to add to it.
+    std::map<std::string, std::string> cached_functions;
+    std::map<std::string, std::string> function_keys;
 };
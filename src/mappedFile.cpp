@@ -0,0 +1,73 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "mappedFile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile( std::filesystem::path const& path ) {
+    int const fd = ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+    struct stat status {};
+    if ( fd < 0 || ::fstat( fd, &status ) < 0 ) {
+        auto const error = errno;
+        if ( fd >= 0 ) {
+            ::close( fd );
+        }
+        throw std::runtime_error( std::format( "Cannot read {}: {}", path.string(), std::strerror( error ) ) );
+    }
+    if ( !S_ISREG( status.st_mode ) ) {
+        // Its size is not known until it has all been read.
+        char    buffer[ 1 << 16 ];
+        ssize_t count = 0;
+        while ( ( count = ::read( fd, buffer, sizeof( buffer ) ) ) != 0 ) {
+            if ( count < 0 && errno != EINTR ) {
+                auto const error = errno;
+                ::close( fd );
+                throw std::runtime_error( std::format( "Cannot read {}: {}", path.string(), std::strerror( error ) ) );
+            }
+            if ( count > 0 ) {
+                contents.append( buffer, static_cast<size_t>( count ) );
+            }
+        }
+        ::close( fd );
+        data = contents.data();
+        size = contents.size();
+        return;
+    }
+    size = static_cast<size_t>( status.st_size );
+    if ( size == 0 ) {
+        ::close( fd );
+        return;
+    }
+
+    void*      mapping = ::mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    auto const error = errno;
+    ::close( fd );
+    if ( mapping == MAP_FAILED ) {
+        throw std::runtime_error( std::format( "Cannot map {}: {}", path.string(), std::strerror( error ) ) );
+    }
+    ::madvise( mapping, size, MADV_SEQUENTIAL ); // read once, front to back, by the lexer
+    data = static_cast<char const*>( mapping );
+    mapped = true;
+}
+
+MappedFile::~MappedFile() {
+    if ( mapped ) {
+        ::munmap( const_cast<char*>( data ), size );
+    }
+}
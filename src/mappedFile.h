@@ -0,0 +1,33 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+// A file mapped read only into memory, so that it can be lexed without copying it. Throws if it cannot be read. Pipes,
+// terminals and other files which are not regular, such as /dev/stdin, are read into memory instead.
+class MappedFile {
+  public:
+    explicit MappedFile( std::filesystem::path const& path );
+    MappedFile( MappedFile const& ) = delete;
+    MappedFile& operator=( MappedFile const& ) = delete;
+    ~MappedFile();
+
+    [[nodiscard]] std::string_view text() const { return { data, size }; }
+
+  private:
+    char const* data { nullptr }; // null for an empty file, which cannot be mapped
+    size_t      size { 0 };
+    bool        mapped { false };
+    std::string contents; // read when the file cannot be mapped
+};
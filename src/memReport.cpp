@@ -0,0 +1,110 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "memReport.h"
+
+#include <print>
+
+#include <sys/resource.h>
+
+#include "nodeCount.h"
+
+std::vector<IRNodeCounts>& node_count_registry() {
+    static std::vector<IRNodeCounts> registry;
+    return registry;
+}
+
+std::size_t peak_rss() {
+    // ru_maxrss is the VmHWM of /proc/self/status on Linux, in kilobytes, and in bytes on macOS.
+    rusage usage {};
+    getrusage( RUSAGE_SELF, &usage );
+#if defined( __APPLE__ )
+    return static_cast<std::size_t>( usage.ru_maxrss );
+#else
+    return static_cast<std::size_t>( usage.ru_maxrss ) * 1024;
+#endif
+}
+
+namespace {
+
+double to_mb( const std::uint64_t bytes ) {
+    return static_cast<double>( bytes ) / ( 1024.0 * 1024.0 );
+}
+
+} // namespace
+
+void MemReport::begin( const std::string_view region, const std::string_view function ) {
+    if ( !function.empty() ) {
+        return;
+    }
+    // Hold the totals at the start, the difference is taken at the end.
+    PauseAllocationCounting const pause;
+    std::lock_guard               lock( mutex );
+    auto&                         stack = open[ std::this_thread::get_id() ];
+    stack.push_back( passes.size() );
+    passes.push_back( Entry { .name = std::string( region ),
+                              .depth = static_cast<int>( stack.size() ) - 1,
+                              .count = allocation_stats.count.load( std::memory_order_relaxed ),
+                              .bytes = allocation_stats.bytes.load( std::memory_order_relaxed ) } );
+}
+
+void MemReport::end( std::string_view /*region*/, const std::string_view function, Timing const& /*timing*/ ) {
+    if ( !function.empty() ) {
+        return;
+    }
+    PauseAllocationCounting const pause;
+    std::lock_guard               lock( mutex );
+    auto&                         stack = open[ std::this_thread::get_id() ];
+    if ( stack.empty() ) {
+        return;
+    }
+    auto& entry = passes[ stack.back() ];
+    stack.pop_back();
+    entry.count = allocation_stats.count.load( std::memory_order_relaxed ) - entry.count;
+    entry.bytes = allocation_stats.bytes.load( std::memory_order_relaxed ) - entry.bytes;
+    entry.peak_rss = peak_rss();
+}
+
+void MemReport::report() {
+    std::println( out, "===--- Memory report ---===" );
+    std::println( out, "  Peak RSS: {:.2f} MB, allocations: {}, {:.2f} MB", to_mb( peak_rss() ),
+                  allocation_stats.count.load(), to_mb( allocation_stats.bytes.load() ) );
+    std::println( out, "" );
+    std::println( out, "{:>12} {:>14} {:>14}  {}", "Allocations", "Bytes", "Peak RSS (MB)", "Pass" );
+    for ( auto const& entry : passes ) {
+        std::println( out, "{:12} {:14} {:14.2f}  {}{}", entry.count, entry.bytes, to_mb( entry.peak_rss ),
+                      std::string( 2 * entry.depth, ' ' ), entry.name );
+    }
+    print_nodes();
+    std::fflush( out );
+}
+
+void MemReport::print_nodes() const {
+    for ( auto const& [ ir, counts ] : node_count_registry() ) {
+        std::size_t created = 0;
+        std::size_t bytes = 0;
+        for ( auto const& count : counts ) {
+            created += count.created;
+            bytes += count.bytes;
+        }
+        if ( created == 0 ) {
+            continue;
+        }
+        std::println( out, "" );
+        std::println( out, "{} nodes: {} created, {:.2f} MB", ir, created, to_mb( bytes ) );
+        std::println( out, "{:>12} {:>12} {:>14}  {}", "Created", "Live", "Bytes", "Type" );
+        for ( auto const& count : counts ) {
+            if ( count.created > 0 ) {
+                std::println( out, "{:12} {:12} {:14}  {}", count.created.load(), count.live.load(),
+                              count.bytes.load(), count.name );
+            }
+        }
+    }
+}
@@ -0,0 +1,76 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "instrument.h"
+
+// Heap allocations, counted by the replacement operator new in the driver.
+struct AllocationStats {
+    std::atomic<std::uint64_t> count { 0 };
+    std::atomic<std::uint64_t> bytes { 0 };
+};
+
+inline AllocationStats   allocation_stats;
+inline bool              allocation_counting { false };
+inline thread_local bool allocation_paused { false }; // by the report's own bookkeeping on this thread
+
+// Leaves the allocations of the thread out of the counts while it is in scope.
+class PauseAllocationCounting {
+  public:
+    PauseAllocationCounting() : was_paused( std::exchange( allocation_paused, true ) ) {};
+    ~PauseAllocationCounting() { allocation_paused = was_paused; };
+    PauseAllocationCounting( PauseAllocationCounting const& ) = delete;
+    PauseAllocationCounting& operator=( PauseAllocationCounting const& ) = delete;
+
+  private:
+    bool was_paused;
+};
+
+// Peak resident set size of the process in bytes, found without allocating.
+std::size_t peak_rss();
+
+// --mem-report: allocations and peak RSS for each pass, and the number of nodes of each IR by type. The allocations
+// are for the whole process, so when files are compiled on several threads a pass includes those of the others.
+class MemReport : public InstrumentListener {
+  public:
+    explicit MemReport( std::FILE* out ) : out( out ) {};
+    ~MemReport() override = default;
+
+    void begin( std::string_view region, std::string_view function ) override;
+    void end( std::string_view region, std::string_view function, Timing const& timing ) override;
+    void report() override;
+
+  private:
+    struct Entry {
+        std::string   name;
+        int           depth { 0 };
+        std::uint64_t count { 0 };
+        std::uint64_t bytes { 0 };
+        std::size_t   peak_rss { 0 };
+    };
+
+    void print_nodes() const;
+
+    std::FILE*                                     out;
+    std::mutex                                     mutex;
+    std::vector<Entry>                             passes;
+    std::map<std::thread::id, std::vector<size_t>> open; // passes begun but not ended, on each thread
+};
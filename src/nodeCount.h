@@ -0,0 +1,55 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Counts of the nodes of one type of an IR, kept by the generated node classes for --mem-report.
+struct NodeCount {
+    std::string_view         name;
+    std::atomic<std::size_t> created { 0 };
+    std::atomic<std::size_t> live { 0 };
+    std::atomic<std::size_t> bytes { 0 }; // of all the nodes created
+};
+
+// Only counted with --mem-report, set before any nodes are created.
+inline bool node_counting { false };
+
+inline void node_created( NodeCount& count, const std::size_t size ) {
+    if ( node_counting ) {
+        count.created.fetch_add( 1, std::memory_order_relaxed );
+        count.live.fetch_add( 1, std::memory_order_relaxed );
+        count.bytes.fetch_add( size, std::memory_order_relaxed );
+    }
+}
+
+inline void node_destroyed( NodeCount& count ) {
+    if ( node_counting ) {
+        count.live.fetch_sub( 1, std::memory_order_relaxed );
+    }
+}
+
+// The node counts of each IR, which register themselves.
+struct IRNodeCounts {
+    std::string_view      ir;
+    std::span<NodeCount> counts;
+};
+
+std::vector<IRNodeCounts>& node_count_registry();
+
+inline bool register_node_counts( const std::string_view ir, const std::span<NodeCount> counts ) {
+    node_count_registry().push_back( { ir, counts } );
+    return true;
+}
@@ -0,0 +1,135 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "token.h"
+
+// The operators and punctuation, and the DFA which the lexer runs to read them, built from the list when compiling. To
+// add an operator, add it to the list. The lexer reads the longest operator, so each prefix of an operator must also be
+// an operator, which the build checks.
+namespace operators {
+
+struct Operator {
+    std::string_view text;
+    TokenType        tok;
+};
+
+constexpr auto list = std::to_array<Operator>( {
+    { "(", TokenType::L_PAREN },
+    { ")", TokenType::R_PAREN },
+    { "{", TokenType::L_BRACE },
+    { "}", TokenType::R_BRACE },
+    { ";", TokenType::SEMICOLON },
+    { "?", TokenType::QUESTION },
+    { ":", TokenType::COLON },
+    { ",", TokenType::COMMA },
+    { "~", TokenType::TILDE },
+    { "#", TokenType::HASH },
+    { "##", TokenType::HASH_HASH },
+    { "+", TokenType::PLUS },
+    { "++", TokenType::INCREMENT },
+    { "+=", TokenType::COMPOUND_PLUS },
+    { "-", TokenType::DASH },
+    { "--", TokenType::DECREMENT },
+    { "-=", TokenType::COMPOUND_MINUS },
+    { "*", TokenType::ASTÉRIX },
+    { "*=", TokenType::COMPOUND_ASTERIX },
+    { "/", TokenType::SLASH },
+    { "/=", TokenType::COMPOUND_SLASH },
+    { "%", TokenType::PERCENT },
+    { "%=", TokenType::COMPOUND_PERCENT },
+    { "&", TokenType::AMPERSAND },
+    { "&&", TokenType::LOGICAL_AND },
+    { "&=", TokenType::COMPOUND_AND },
+    { "|", TokenType::PIPE },
+    { "||", TokenType::LOGICAL_OR },
+    { "|=", TokenType::COMPOUND_OR },
+    { "^", TokenType::CARET },
+    { "^=", TokenType::COMPOUND_XOR },
+    { "!", TokenType::EXCLAMATION },
+    { "!=", TokenType::COMPARISON_NOT },
+    { "=", TokenType::EQUALS },
+    { "==", TokenType::COMPARISON_EQUALS },
+    { "<", TokenType::LESS },
+    { "<=", TokenType::LESS_EQUALS },
+    { "<<", TokenType::LEFT_SHIFT },
+    { "<<=", TokenType::COMPOUND_LEFT_SHIFT },
+    { ">", TokenType::GREATER },
+    { ">=", TokenType::GREATER_EQUALS },
+    { ">>", TokenType::RIGHT_SHIFT },
+    { ">>=", TokenType::COMPOUND_RIGHT_SHIFT },
+} );
+
+// The characters used in operators each have a class, from 1, and all other characters are class 0.
+constexpr size_t count_classes() {
+    std::array<bool, 256> used {};
+    size_t                classes = 1;
+    for ( auto const& op : list ) {
+        for ( auto const c : op.text ) {
+            if ( !used[ static_cast<unsigned char>( c ) ] ) {
+                used[ static_cast<unsigned char>( c ) ] = true;
+                ++classes;
+            }
+        }
+    }
+    return classes;
+}
+
+// A state for each operator, and the start state 0.
+constexpr size_t states = list.size() + 1;
+constexpr size_t classes = count_classes();
+
+struct Dfa {
+    std::array<std::uint8_t, 256>                         char_class {};
+    std::array<std::array<std::uint8_t, classes>, states> next {};   // 0 is no transition
+    std::array<TokenType, states>                         accept {}; // the token read on stopping in the state
+};
+
+// The states are the nodes of a trie of the operators. The state of an operator is found by following the trie from the
+// start with the characters before its last, so the operators must be in an order where each prefix comes first.
+constexpr Dfa build() {
+    Dfa    dfa;
+    size_t classes_used = 1;
+    for ( auto const& op : list ) {
+        for ( auto const c : op.text ) {
+            auto& char_class = dfa.char_class[ static_cast<unsigned char>( c ) ];
+            if ( char_class == 0 ) {
+                char_class = static_cast<std::uint8_t>( classes_used++ );
+            }
+        }
+    }
+
+    size_t states_used = 1;
+    for ( auto const& op : list ) {
+        size_t state = 0;
+        for ( auto const c : op.text.substr( 0, op.text.size() - 1 ) ) {
+            state = dfa.next[ state ][ dfa.char_class[ static_cast<unsigned char>( c ) ] ];
+            if ( state == 0 ) {
+                throw "operators::list has an operator before its prefix";
+            }
+        }
+        auto& next = dfa.next[ state ][ dfa.char_class[ static_cast<unsigned char>( op.text.back() ) ] ];
+        if ( next != 0 ) {
+            throw "operators::list has an operator twice";
+        }
+        next = static_cast<std::uint8_t>( states_used );
+        dfa.accept[ states_used++ ] = op.tok;
+    }
+    return dfa;
+}
+
+constexpr Dfa dfa = build();
+
+} // namespace operators
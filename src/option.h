@@ -6,7 +6,14 @@
 
 #pragma once
 
+#include <cstdio>
 #include <string>
+#include <vector>
+
+class CompileCache;
+class IncludeCache;
+class Instrumentation;
+struct Prelude;
 
 enum Stages {
     None = 0,
@@ -19,6 +26,16 @@ enum Stages {
     All = Lex | Parse | CodeGen | Semantic | Tac | File
 };
 
+// Points in the back end where the assembly tree can be dumped.
+enum AsmDump {
+    AsmNone = 0,
+    AsmGen = 0x1,    // after assembly generation
+    AsmPseudo = 0x2, // after replacing pseudo registers
+    AsmFix = 0x4,    // after fixing instructions
+    AsmFinal = 0x8,  // the final assembly text
+    AsmAll = AsmGen | AsmPseudo | AsmFix | AsmFinal
+};
+
 enum class Machine {
     X86_64,
     AArch64,
@@ -41,6 +58,19 @@ enum class System {
     MacOS,
 };
 
+// The system the compiler is running on, the default target.
+constexpr System host_system() {
+#if defined( __APPLE__ ) && defined( __MACH__ )
+    return System::MacOS;
+#elif defined( __FreeBSD__ )
+    return System::FreeBSD;
+#elif defined( __linux__ ) || defined( __unix__ )
+    return System::Linux;
+#else
+    return System::MacOS;
+#endif
+}
+
 class Option {
   public:
     bool        silent { false };
@@ -48,4 +78,36 @@ class Option {
     std::string input_file;
     Machine     machine { Machine::X86_64 };
     System      system { System::MacOS };
+
+    // Batch compilation: each of the input files is compiled with input_file set to it, on up to jobs threads
+    std::vector<std::string> input_files;
+    int                      jobs { 1 };
+
+    // Preprocessor
+    std::vector<std::string> include_paths; // -I, searched for #include
+    std::vector<std::string> defines;       // -D, name or name=value
+    IncludeCache*            include_cache { nullptr }; // shared by the compilations, null to read each #include
+
+    // Declarations compiled before, which the symbol table starts with. Null for none
+    Prelude const* prelude { nullptr };
+
+    // The assembly of earlier compilations, null to always compile
+    CompileCache* compile_cache { nullptr };
+
+    // IR dumps, all off by default
+    bool       dump_ast { false };
+    bool       dump_sema { false };
+    bool       dump_tac { false };
+    AsmDump    dump_asm { AsmDump::AsmNone };
+    std::FILE* dump_file { stdout };
+
+    // Any IR is dumped, so the compilation must run rather than be found in the compile cache.
+    [[nodiscard]] bool dumping() const { return dump_ast || dump_sema || dump_tac || dump_asm != AsmDump::AsmNone; }
+
+    // Optimisation
+    int                      opt_level { 0 };
+    std::vector<std::string> passes; // explicit pass list, overrides opt_level
+
+    // Timing and other reports, null when off
+    Instrumentation* instrument { nullptr };
 };
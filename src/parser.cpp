@@ -11,7 +11,6 @@
 #include "parser.h"
 #include "ast/includes.h"
 #include "exception.h"
-#include "spdlog/spdlog.h"
 
 #include <functional>
 #include <map>
@@ -74,18 +73,18 @@ ast::Program Parser::parse() {
         token = lexer.peek_token();
     }
     expect_token( TokenType::Eof );
-    spdlog::debug( "Finish parse." );
+    context.logger->debug( "Finish parse." );
     return program;
 }
 
 ast::Declaration Parser::declaration() {
-    spdlog::debug( "declaration" );
+    context.logger->debug( "declaration" );
     ast::Declaration       declaration;
     StorageClass           storage_class = StorageClass::None;
     auto                   token = lexer.peek_token();
     std::vector<TokenType> type_tokens;
     while ( token.tok != TokenType::IDENTIFIER ) {
-        spdlog::debug( "declaration: token {}", to_string( token.tok ) );
+        context.logger->debug( "declaration: token {}", to_string( token.tok ) );
         switch ( token.tok ) {
         case TokenType::STATIC :
             if ( storage_class != StorageClass::None ) {
@@ -120,7 +119,7 @@ ast::Declaration Parser::declaration() {
 
     // Get name
     const std::string name = expect_token( TokenType::IDENTIFIER ).value;
-    spdlog::debug( "declaration: name {}", name );
+    context.logger->debug( "declaration: name {}", name );
 
     // Determine function or variable
     token = lexer.peek_token();
@@ -135,7 +134,7 @@ ast::Declaration Parser::declaration() {
 }
 
 void Parser::function_params( ast::FunctionDef f ) {
-    spdlog::debug( "function_params" );
+    context.logger->debug( "function_params" );
     auto token = lexer.peek_token();
     if ( token.tok == TokenType::VOID ) {
         // void
@@ -189,7 +188,7 @@ ast::FunctionDef Parser::functionDef( std::string const& name, Type type, Storag
     function_params( funct );
     expect_token( TokenType::R_PAREN );
 
-    auto token = lexer.peek_token();
+    auto const& token = lexer.peek_token();
     if ( token.tok == TokenType::SEMICOLON ) {
         // Function declaration
         expect_token( TokenType::SEMICOLON );
@@ -202,14 +201,14 @@ ast::FunctionDef Parser::functionDef( std::string const& name, Type type, Storag
 }
 
 ast::VariableDef Parser::variableDef( std::string const& name, Type type, StorageClass storage_class ) {
-    spdlog::debug( "declaration" );
+    context.logger->debug( "declaration" );
     auto decl = make_AST<ast::VariableDef_>();
     decl->name = name;
     decl->storage = storage_class;
     decl->var_type = type;
 
     // check for =
-    auto token = lexer.peek_token();
+    auto const& token = lexer.peek_token();
     if ( token.tok == TokenType::EQUALS ) {
         expect_token( TokenType::EQUALS );
         decl->init = expr();
@@ -236,26 +235,26 @@ const std::map<TokenType, StatementParselet> statement_map {
 };
 
 ast::Statement Parser::statement() {
-    spdlog::debug( "statement" );
+    context.logger->debug( "statement" );
     ast::Statement stat = make_AST<ast::Statement_>();
 
-    auto token = lexer.peek_token();
+    auto tok = lexer.peek_token().tok;
 
     // Check if the token is a label
-    if ( token.tok == TokenType::IDENTIFIER && lexer.peek_token( 1 ).tok == TokenType::COLON ) {
+    if ( tok == TokenType::IDENTIFIER && lexer.peek_token( 1 ).tok == TokenType::COLON ) {
         stat->label = label();
-        token = lexer.peek_token(); // Get the next token after the label
+        tok = lexer.peek_token().tok; // Get the next token after the label
     }
 
     // Check if the next token is also a label, then finish this statement
-    if ( token.tok == TokenType::IDENTIFIER && lexer.peek_token( 1 ).tok == TokenType::COLON ) {
+    if ( tok == TokenType::IDENTIFIER && lexer.peek_token( 1 ).tok == TokenType::COLON ) {
         // This is just a label, so we just return the label
         return stat;
     }
 
-    if ( statement_map.contains( token.tok ) ) {
+    if ( auto const parselet = statement_map.find( tok ); parselet != statement_map.end() ) {
         // Use the parselet for the statement
-        stat->statement = statement_map.at( token.tok )( this );
+        stat->statement = parselet->second( this );
     } else {
 
         stat->statement = expr();
@@ -265,13 +264,12 @@ ast::Statement Parser::statement() {
 }
 
 ast::Compound Parser::compound() {
-    spdlog::debug( "compound" );
+    context.logger->debug( "compound" );
     expect_token( TokenType::L_BRACE );
     auto compound = make_AST<ast::Compound_>();
 
-    auto token = lexer.peek_token();
-    while ( token.tok != TokenType::R_BRACE ) {
-        if ( is_type_or_storage( token ) ) {
+    while ( lexer.peek_token().tok != TokenType::R_BRACE ) {
+        if ( is_type_or_storage( lexer.peek_token() ) ) {
             auto d = declaration();
             if ( std::holds_alternative<ast::FunctionDef>( d ) ) {
                 compound->block_items.emplace_back( std::get<ast::FunctionDef>( d ) );
@@ -282,7 +280,6 @@ ast::Compound Parser::compound() {
             ast::BlockItem block = statement();
             compound->block_items.push_back( block );
         }
-        token = lexer.peek_token();
     }
 
     // }
@@ -291,14 +288,14 @@ ast::Compound Parser::compound() {
 }
 
 ast::If Parser::if_stat() {
-    spdlog::debug( "if" );
+    context.logger->debug( "if" );
     auto if_stat = make_AST<ast::If_>();
     expect_token( TokenType::IF );
     expect_token( TokenType::L_PAREN );
     if_stat->condition = expr();
     expect_token( TokenType::R_PAREN );
     if_stat->then = statement();
-    auto token = lexer.peek_token();
+    auto const& token = lexer.peek_token();
     if ( token.tok == TokenType::ELSE ) {
         expect_token( TokenType::ELSE );
         if_stat->else_stat = statement();
@@ -307,7 +304,7 @@ ast::If Parser::if_stat() {
 }
 
 ast::Goto Parser::goto_stat() {
-    spdlog::debug( "goto" );
+    context.logger->debug( "goto" );
     auto goto_stat = make_AST<ast::Goto_>();
     expect_token( TokenType::GOTO );
     goto_stat->label = expect_token( TokenType::IDENTIFIER ).value;
@@ -316,7 +313,7 @@ ast::Goto Parser::goto_stat() {
 }
 
 ast::Label Parser::label() {
-    spdlog::debug( "label" );
+    context.logger->debug( "label" );
     auto label = make_AST<ast::Label_>();
     auto token = expect_token( TokenType::IDENTIFIER );
     label->label = token.value;
@@ -325,21 +322,21 @@ ast::Label Parser::label() {
 }
 
 ast::Break Parser::break_stat() {
-    spdlog::debug( "break" );
+    context.logger->debug( "break" );
     expect_token( TokenType::BREAK );
     expect_token( TokenType::SEMICOLON );
     return make_AST<ast::Break_>();
 }
 
 ast::Continue Parser::continue_stat() {
-    spdlog::debug( "continue" );
+    context.logger->debug( "continue" );
     expect_token( TokenType::CONTINUE );
     expect_token( TokenType::SEMICOLON );
     return make_AST<ast::Continue_>();
 }
 
 ast::While Parser::while_stat() {
-    spdlog::debug( "while" );
+    context.logger->debug( "while" );
     auto while_stat = make_AST<ast::While_>();
     expect_token( TokenType::WHILE );
     expect_token( TokenType::L_PAREN );
@@ -350,7 +347,7 @@ ast::While Parser::while_stat() {
 }
 
 ast::DoWhile Parser::do_while_stat() {
-    spdlog::debug( "do while" );
+    context.logger->debug( "do while" );
     auto do_while_stat = make_AST<ast::DoWhile_>();
     expect_token( TokenType::DO );
     do_while_stat->body = statement();
@@ -363,13 +360,13 @@ ast::DoWhile Parser::do_while_stat() {
 }
 
 ast::For Parser::for_stat() {
-    spdlog::debug( "for" );
+    context.logger->debug( "for" );
     auto for_stat = make_AST<ast::For_>();
     expect_token( TokenType::FOR );
     expect_token( TokenType::L_PAREN );
 
     // Init
-    auto token = lexer.peek_token();
+    auto const& token = lexer.peek_token();
     if ( token.tok != TokenType::SEMICOLON ) {
         // Test for storage specifiers
         if ( is_type_or_storage( token ) ) {
@@ -389,7 +386,7 @@ ast::For Parser::for_stat() {
         expect_token( TokenType::SEMICOLON );
     }
 
-    spdlog::debug( "for - condition" );
+    context.logger->debug( "for - condition" );
     // Condition
     if ( lexer.peek_token().tok != TokenType::SEMICOLON ) {
         for_stat->condition = expr();
@@ -407,7 +404,7 @@ ast::For Parser::for_stat() {
 }
 
 ast::Switch Parser::switch_stat() {
-    spdlog::debug( "switch" );
+    context.logger->debug( "switch" );
     auto switch_stat = make_AST<ast::Switch_>();
     expect_token( TokenType::SWITCH );
     expect_token( TokenType::L_PAREN );
@@ -418,11 +415,11 @@ ast::Switch Parser::switch_stat() {
 }
 
 ast::Case Parser::case_stat() {
-    spdlog::debug( "case" );
+    context.logger->debug( "case" );
 
     auto case_stat = make_AST<ast::Case_>();
     auto token = lexer.get_token();
-    spdlog::debug( "case: {}", to_string( token.tok ) );
+    context.logger->debug( "case: {}", to_string( token.tok ) );
     if ( token.tok == TokenType::DEFAULT ) {
         case_stat->is_default = true;
     } else if ( token.tok == TokenType::CASE ) {
@@ -437,7 +434,7 @@ ast::Case Parser::case_stat() {
     token = lexer.peek_token();
     bool first = true;
     while ( token.tok != TokenType::CASE && token.tok != TokenType::DEFAULT && token.tok != TokenType::R_BRACE ) {
-        spdlog::debug( "case: statement {}", to_string( token.tok ) );
+        context.logger->debug( "case: statement {}", to_string( token.tok ) );
         if ( is_type_or_storage( token ) ) {
             if ( first ) {
                 throw ParseException( lexer.get_location(), "Declaration not allowed in C17." );
@@ -460,7 +457,7 @@ ast::Case Parser::case_stat() {
 }
 
 ast::Return Parser::ret() {
-    spdlog::debug( "ret" );
+    context.logger->debug( "ret" );
     auto ret = make_AST<ast::Return_>();
     expect_token( TokenType::RETURN );
     ret->expr = expr();
@@ -524,32 +521,32 @@ const std::map<TokenType, InfixParselet> infix_map {
 };
 
 ast::Expr Parser::expr( const Precedence precedence ) {
-    spdlog::debug( "expr( {} )", static_cast<int>( precedence ) );
+    context.logger->debug( "expr( {} )", static_cast<int>( precedence ) );
     auto left = factor();
 
     // Get second expression
-    auto token = lexer.peek_token();
-    while ( infix_map.contains( token.tok ) && get_precedence( token.tok ) >= precedence ) {
-        left = infix_map.at( token.tok )( this, left );
-        token = lexer.peek_token();
+    auto tok = lexer.peek_token().tok;
+    while ( infix_map.contains( tok ) && get_precedence( tok ) >= precedence ) {
+        left = infix_map.at( tok )( this, left );
+        tok = lexer.peek_token().tok;
     }
     return left;
 }
 
 ast::Expr Parser::factor() {
-    spdlog::debug( "factor()" );
-    auto token = lexer.peek_token();
-    auto parselet = prefix_map.find( token.tok );
+    context.logger->debug( "factor()" );
+    auto const& token = lexer.peek_token();
+    auto        parselet = prefix_map.find( token.tok );
     if ( parselet == prefix_map.end() ) {
         throw ParseException( token.location, "Unexpected token {}", token );
     }
-    auto left = prefix_map.at( token.tok )( this );
+    auto left = parselet->second( this );
 
     // Look for postfix operators
-    token = lexer.peek_token();
-    if ( token.tok == TokenType::INCREMENT || token.tok == TokenType::DECREMENT ) {
+    auto const next = lexer.peek_token().tok;
+    if ( next == TokenType::INCREMENT || next == TokenType::DECREMENT ) {
         return postfixOp( ast::Expr( left ) );
-    } else if ( token.tok == TokenType::L_PAREN ) {
+    } else if ( next == TokenType::L_PAREN ) {
         // Function call
         return call( ast::Expr( left ) );
     }
@@ -557,7 +554,7 @@ ast::Expr Parser::factor() {
 }
 
 ast::UnaryOp Parser::unaryOp() {
-    spdlog::debug( "unaryOp()" );
+    context.logger->debug( "unaryOp()" );
     auto token = lexer.get_token();
     auto op = make_AST<ast::UnaryOp_>();
     op->op = token.tok;
@@ -566,7 +563,7 @@ ast::UnaryOp Parser::unaryOp() {
 }
 
 ast::BinaryOp Parser::binaryOp( ast::Expr left ) {
-    spdlog::debug( "binaryOp()" );
+    context.logger->debug( "binaryOp()" );
     auto token = lexer.get_token();
     auto op = make_AST<ast::BinaryOp_>();
     op->left = std::move( left );
@@ -576,7 +573,7 @@ ast::BinaryOp Parser::binaryOp( ast::Expr left ) {
 }
 
 ast::PostOp Parser::postfixOp( ast::Expr left ) {
-    spdlog::debug( "postfixOp()" );
+    context.logger->debug( "postfixOp()" );
     auto token = lexer.get_token();
     auto op = make_AST<ast::PostOp_>();
     op->operand = std::move( left );
@@ -586,7 +583,7 @@ ast::PostOp Parser::postfixOp( ast::Expr left ) {
 }
 
 ast::Conditional Parser::conditional( ast::Expr left ) {
-    spdlog::debug( "conditional()" );
+    context.logger->debug( "conditional()" );
     auto token = lexer.get_token();
     auto op = make_AST<ast::Conditional_>();
     op->condition = std::move( left );
@@ -597,7 +594,7 @@ ast::Conditional Parser::conditional( ast::Expr left ) {
 }
 
 ast::Assign Parser::assign( ast::Expr left ) {
-    spdlog::debug( "assign()" );
+    context.logger->debug( "assign()" );
     auto token = lexer.get_token();
     auto op = make_AST<ast::Assign_>();
     op->left = std::move( left );
@@ -607,7 +604,7 @@ ast::Assign Parser::assign( ast::Expr left ) {
 }
 
 ast::Call Parser::call( ast::Expr left ) {
-    spdlog::debug( "call()" );
+    context.logger->debug( "call()" );
 
     auto token = expect_token( TokenType::L_PAREN );
     auto call = make_AST<ast::Call_>();
@@ -637,9 +634,9 @@ ast::Call Parser::call( ast::Expr left ) {
 }
 
 ast::Expr Parser::l_paren() {
-    spdlog::debug( "l_paren()" );
+    context.logger->debug( "l_paren()" );
     lexer.get_token(); // (
-    auto token = lexer.peek_token();
+    auto const& token = lexer.peek_token();
     if ( is_type( token ) ) {
         return cast();
     }
@@ -647,14 +644,14 @@ ast::Expr Parser::l_paren() {
 }
 
 ast::Expr Parser::group() {
-    spdlog::debug( "group()" );
+    context.logger->debug( "group()" );
     auto e = expr( Precedence::Lowest );
     expect_token( TokenType::R_PAREN );
     return e;
 }
 
 ast::Cast Parser::cast() {
-    spdlog::debug( "cast()" );
+    context.logger->debug( "cast()" );
     auto                   cast = make_AST<ast::Cast_>();
     std::vector<TokenType> types;
     auto                   token = lexer.peek_token();
@@ -670,11 +667,14 @@ ast::Cast Parser::cast() {
 }
 
 ast::Constant Parser::constant() {
-    spdlog::debug( "constant()" );
+    context.logger->debug( "constant()" );
     auto token = lexer.get_token();
-    spdlog::debug( "constant(): {}", token.value );
+    context.logger->debug( "constant(): {}", token.value );
+    if ( token.number > static_cast<std::uint64_t>( std::numeric_limits<std::int64_t>::max() ) ) {
+        throw ParseException( token.location, "Constant {} is too large", token.value );
+    }
     if ( token.tok == TokenType::CONSTANT ) {
-        auto value = std::stoll( token.value );
+        auto value = static_cast<std::int64_t>( token.number );
         if ( value <= std::numeric_limits<std::int32_t>::max() && value > std::numeric_limits<std::int32_t>::min() ) {
             auto constant = make_AST<ast::ConstantInt_>();
             constant->value = static_cast<std::int32_t>( value );
@@ -685,14 +685,14 @@ ast::Constant Parser::constant() {
         return constant;
     } else if ( token.tok == TokenType::LONGLITERAL ) {
         auto constant = make_AST<ast::ConstantLong_>();
-        constant->value = std::stoll( token.value );
+        constant->value = static_cast<std::int64_t>( token.number );
         return constant;
     }
     throw ParseException( token.location, "Expected constant but found {}", token );
 }
 
 ast::Var Parser::var() {
-    spdlog::debug( "var()" );
+    context.logger->debug( "var()" );
     auto token = lexer.get_token();
     auto var = make_AST<ast::Var_>();
     var->name = token.value;
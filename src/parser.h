@@ -11,6 +11,7 @@
 #pragma once
 
 #include "ast/includes.h"
+#include "compilationContext.h"
 #include "lexer.h"
 
 enum class Precedence {
@@ -33,7 +34,7 @@ enum class Precedence {
 
 class Parser {
   public:
-    explicit Parser( Lexer& lexer ) : lexer( lexer ) {};
+    Parser( TokenStream& lexer, CompilationContext& context ) : lexer( lexer ), context( context ) {};
     ~Parser() = default;
 
     ast::Program parse();
@@ -79,5 +80,6 @@ class Parser {
 
     Token expect_token( TokenType expected );
 
-    Lexer& lexer;
+    TokenStream&        lexer;
+    CompilationContext& context;
 };
@@ -0,0 +1,97 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 16/10/2026.
+//
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "instrument.h"
+
+// A pass over a whole program (module) of one of the intermediate representations, TAC, x86_at or arm64_at.
+template <typename Program> class Pass {
+  public:
+    Pass() = default;
+    virtual ~Pass() = default;
+
+    [[nodiscard]] virtual std::string_view name() const = 0;
+    virtual void                           run( Program program ) = 0;
+
+    void set_instrumentation( Instrumentation const* i ) { instrument = i; }
+    void set_logger( spdlog::logger* l ) { logger = l; }
+
+  protected:
+    Instrumentation const* instrument { nullptr };
+    spdlog::logger*        logger { spdlog::default_logger_raw() };
+};
+
+// A pass which runs over each function of a program independently.
+template <typename Program, typename Function> class FunctionPass : public Pass<Program> {
+  public:
+    void run( Program program ) override {
+        if constexpr ( requires { program->top_level; } ) {
+            for ( auto const& item : program->top_level ) {
+                if ( auto function = std::get_if<Function>( &item ) ) {
+                    Region region( this->instrument, this->name(), ( *function )->name );
+                    run_on_function( *function );
+                }
+            }
+        } else {
+            // arm64_at has only one function
+            Region region( this->instrument, this->name(), program->function->name );
+            run_on_function( program->function );
+        }
+    }
+
+    virtual void run_on_function( Function function ) = 0;
+};
+
+// Runs a pipeline of passes in order over a program.
+template <typename Program> class PassManager {
+  public:
+    using Hook = std::function<void( std::string_view pass, Program program )>;
+
+    void add( std::unique_ptr<Pass<Program>> pass ) { passes.push_back( std::move( pass ) ); }
+
+    // Called after each pass has run, used for dumping the IR.
+    void add_hook( Hook hook ) { hooks.push_back( std::move( hook ) ); }
+
+    void set_instrumentation( Instrumentation const* i ) { instrument = i; }
+    void set_logger( spdlog::logger* l ) { logger = l; }
+
+    void run( Program program ) {
+        for ( auto const& pass : passes ) {
+            logger->info( "Run pass {},", pass->name() );
+            {
+                Region region( instrument, pass->name() );
+                pass->set_instrumentation( instrument );
+                pass->set_logger( logger );
+                pass->run( program );
+            }
+            for ( auto const& hook : hooks ) {
+                hook( pass->name(), program );
+            }
+        }
+    }
+
+    [[nodiscard]] bool   empty() const { return passes.empty(); }
+    [[nodiscard]] size_t size() const { return passes.size(); }
+
+  private:
+    std::vector<std::unique_ptr<Pass<Program>>> passes;
+    std::vector<Hook>                           hooks;
+    Instrumentation const*                      instrument { nullptr };
+    spdlog::logger*                             logger { spdlog::default_logger_raw() };
+};
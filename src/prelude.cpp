@@ -0,0 +1,138 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "prelude.h"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "hash.h"
+#include "mappedFile.h"
+
+namespace {
+
+constexpr std::string_view header = "axc-prelude 2";
+
+constexpr std::array types { Type::VOID, Type::INT, Type::LONG, Type::FUNCTION };
+constexpr std::array storages { StorageClass::None, StorageClass::Static, StorageClass::Extern,
+                                StorageClass::Parameter };
+constexpr std::array initialisers { Initialiser::None, Initialiser::Tentative, Initialiser::Final };
+
+std::string to_string( Initialiser const initialiser ) {
+    switch ( initialiser ) {
+    case Initialiser::None :
+        return "none";
+    case Initialiser::Tentative :
+        return "tentative";
+    case Initialiser::Final :
+        return "final";
+    }
+    return "none";
+}
+
+// The value of an enum from the name written by to_string.
+template <typename E, size_t N> E parse( std::string const& word, std::array<E, N> const& values ) {
+    auto const found = std::ranges::find_if( values, [ &word ]( E value ) { return to_string( value ) == word; } );
+    if ( found == values.end() ) {
+        throw std::runtime_error( std::format( "Bad prelude: unknown value {}", word ) );
+    }
+    return *found;
+}
+
+} // namespace
+
+Prelude make_prelude( std::string const& source, SymbolTable const& symbols ) {
+    for ( auto const& [ name, symbol ] : symbols ) {
+        bool const defined = symbol.type == Type::FUNCTION ? symbol.storage == StorageClass::Static
+                                                           : symbol.storage != StorageClass::Extern;
+        if ( defined ) {
+            throw std::runtime_error( std::format( "A prelude can only declare extern symbols: {} is defined", name ) );
+        }
+    }
+    Prelude prelude { .source = std::filesystem::weakly_canonical( source ).string() };
+    prelude.hash = source_hash( prelude.source );
+    prelude.symbols.copy( symbols );
+    return prelude;
+}
+
+void write_prelude( std::ostream& out, Prelude const& prelude ) {
+    out << header << "\nsource " << prelude.source << "\nhash " << prelude.hash << '\n';
+    for ( auto const& [ name, symbol ] : prelude.symbols ) {
+        out << std::format( "{} {} {} {} {} {} {}", name, to_string( symbol.storage ), to_string( symbol.type ),
+                            symbol.number, to_string( symbol.initaliser ), symbol.global ? 1 : 0,
+                            to_string( symbol.function_type.return_type ) );
+        for ( auto const type : symbol.function_type.parameter_types ) {
+            out << ' ' << to_string( type );
+        }
+        out << '\n';
+    }
+}
+
+Prelude read_prelude( std::istream& in ) {
+    std::string line;
+    if ( !std::getline( in, line ) || line != header ) {
+        throw std::runtime_error( "Bad prelude: not a prelude file" );
+    }
+    Prelude prelude;
+    if ( !std::getline( in, line ) || !line.starts_with( "source " ) ) {
+        throw std::runtime_error( "Bad prelude: no source" );
+    }
+    prelude.source = line.substr( std::string_view( "source " ).size() );
+    if ( !std::getline( in, line ) || !line.starts_with( "hash " ) ) {
+        throw std::runtime_error( "Bad prelude: no hash" );
+    }
+    prelude.hash = line.substr( std::string_view( "hash " ).size() );
+
+    while ( std::getline( in, line ) ) {
+        std::istringstream fields( line );
+        std::string        storage, type, initialiser, return_type;
+        int                global { 0 };
+        Symbol             symbol;
+        if ( !( fields >> symbol.name >> storage >> type >> symbol.number >> initialiser >> global >> return_type ) ) {
+            throw std::runtime_error( std::format( "Bad prelude: {}", line ) );
+        }
+        symbol.storage = parse( storage, storages );
+        symbol.type = parse( type, types );
+        symbol.initaliser = parse( initialiser, initialisers );
+        symbol.global = global != 0;
+        symbol.function_type.return_type = parse( return_type, types );
+        for ( std::string parameter; fields >> parameter; ) {
+            symbol.function_type.parameter_types.push_back( parse( parameter, types ) );
+        }
+        symbol.current_scope = true; // declared at file scope
+        prelude.symbols.put( symbol.name, symbol );
+    }
+    return prelude;
+}
+
+Prelude read_prelude( std::filesystem::path const& path ) {
+    std::ifstream in { path };
+    if ( !in ) {
+        throw std::runtime_error( std::format( "Cannot read prelude {}", path.string() ) );
+    }
+    return read_prelude( in );
+}
+
+std::string source_hash( std::filesystem::path const& path ) {
+    try {
+        MappedFile const file( path );
+        return Hash().add( file.text() ).hex();
+    } catch ( const std::exception& ) {
+        return {};
+    }
+}
+
+bool is_current( Prelude const& prelude ) {
+    return !prelude.hash.empty() && source_hash( prelude.source ) == prelude.hash;
+}
@@ -0,0 +1,45 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <filesystem>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "symbolTable.h"
+
+// A precompiled prelude: the file scope symbols of a file of extern declarations, saved after semantic analysis. A
+// compilation with a prelude starts with its symbols, and does not read the file again when it is included. Macros
+// defined in the file are not kept. A prelude whose file has changed since it was made is not used, and the file is
+// included as usual.
+struct Prelude {
+    std::string source; // canonical path of the file
+    std::string hash;   // of the contents of the file when the prelude was made
+    SymbolTable symbols;
+};
+
+// The prelude of the file source with the symbols of its compilation. Throws std::runtime_error if a symbol is
+// defined rather than declared, as a prelude has no code.
+Prelude make_prelude( std::string const& source, SymbolTable const& symbols );
+
+// A prelude is saved as text, one line for each symbol.
+void    write_prelude( std::ostream& out, Prelude const& prelude );
+Prelude read_prelude( std::istream& in );
+
+// Throws std::runtime_error if the file can't be read or isn't a prelude.
+Prelude read_prelude( std::filesystem::path const& path );
+
+// The hash of the contents of a file, empty if it can't be read.
+std::string source_hash( std::filesystem::path const& path );
+
+// Whether the file of the prelude is as it was when the prelude was made.
+bool is_current( Prelude const& prelude );
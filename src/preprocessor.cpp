@@ -0,0 +1,732 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "preprocessor.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <limits>
+
+#include "exception.h"
+#include "prelude.h"
+
+namespace {
+
+constexpr size_t max_include_depth = 200;
+
+// A value in an #if: intmax_t, or uintmax_t when an operand is, as for a number too large for intmax_t.
+struct IfValue {
+    std::uintmax_t bits { 0 };
+    bool           is_unsigned { false };
+
+    [[nodiscard]] std::intmax_t as_signed() const { return static_cast<std::intmax_t>( bits ); }
+};
+
+// Evaluate the expression of an #if, after the macros have been expanded. Signed arithmetic is checked, so that
+// overflow, and shifts by negative or too large counts, are errors rather than undefined behaviour. Errors in an
+// operand which is not evaluated, as in 0 && 1 / 0, are ignored.
+class IfExpression {
+  public:
+    IfExpression( std::vector<Token> const& tokens, Location location ) : tokens( tokens ), location( location ) {};
+
+    IfValue evaluate() {
+        auto const value = conditional();
+        if ( next < tokens.size() ) {
+            throw PreprocessorException( location, "Unexpected {} in #if", spelling( tokens[ next ] ) );
+        }
+        return value;
+    }
+
+  private:
+    [[nodiscard]] TokenType peek() const { return next < tokens.size() ? tokens[ next ].tok : TokenType::Eof; }
+
+    void expect( TokenType const t ) {
+        if ( peek() != t ) {
+            throw PreprocessorException( location, "Expected {} in #if", to_string( t ) );
+        }
+        ++next;
+    }
+
+    static int precedence( TokenType const t ) {
+        switch ( t ) {
+            using enum TokenType;
+        case LOGICAL_OR :
+            return 1;
+        case LOGICAL_AND :
+            return 2;
+        case PIPE :
+            return 3;
+        case CARET :
+            return 4;
+        case AMPERSAND :
+            return 5;
+        case COMPARISON_EQUALS :
+        case COMPARISON_NOT :
+            return 6;
+        case LESS :
+        case GREATER :
+        case LESS_EQUALS :
+        case GREATER_EQUALS :
+            return 7;
+        case LEFT_SHIFT :
+        case RIGHT_SHIFT :
+            return 8;
+        case PLUS :
+        case DASH :
+            return 9;
+        case ASTÉRIX :
+        case SLASH :
+        case PERCENT :
+            return 10;
+        default :
+            return 0;
+        }
+    }
+
+    static IfValue truth( bool const value ) { return { value ? 1U : 0U, false }; }
+
+    static IfValue signed_value( std::intmax_t const value ) { return { static_cast<std::uintmax_t>( value ), false }; }
+
+    // The error, or 0 when it is in an operand which is not evaluated.
+    [[nodiscard]] IfValue failed( std::string message ) const {
+        if ( unevaluated == 0 ) {
+            throw PreprocessorException( location, std::move( message ) );
+        }
+        return {};
+    }
+
+    IfValue conditional() {
+        auto const condition = binary( 1 );
+        if ( peek() != TokenType::QUESTION ) {
+            return condition;
+        }
+        ++next;
+        unevaluated += condition.bits == 0 ? 1 : 0;
+        auto const left = conditional();
+        unevaluated -= condition.bits == 0 ? 1 : 0;
+        expect( TokenType::COLON );
+        unevaluated += condition.bits != 0 ? 1 : 0;
+        auto const right = conditional();
+        unevaluated -= condition.bits != 0 ? 1 : 0;
+        return { condition.bits != 0 ? left.bits : right.bits, left.is_unsigned || right.is_unsigned };
+    }
+
+    IfValue binary( int const min_precedence ) {
+        auto left = unary();
+        for ( auto op = peek(); precedence( op ) >= min_precedence && precedence( op ) > 0; op = peek() ) {
+            ++next;
+            size_t const skip = ( op == TokenType::LOGICAL_OR && left.bits != 0 ) ||
+                                        ( op == TokenType::LOGICAL_AND && left.bits == 0 )
+                                    ? 1
+                                    : 0;
+            unevaluated += skip;
+            auto const right = binary( precedence( op ) + 1 );
+            unevaluated -= skip;
+            left = apply( op, left, right );
+        }
+        return left;
+    }
+
+    [[nodiscard]] IfValue apply( TokenType const op, IfValue const left, IfValue const right ) const {
+        // The usual arithmetic conversions: unsigned if either operand is.
+        bool const    is_unsigned = left.is_unsigned || right.is_unsigned;
+        auto const    l = left.as_signed();
+        auto const    r = right.as_signed();
+        std::intmax_t result = 0;
+        switch ( op ) {
+            using enum TokenType;
+        case LOGICAL_OR :
+            return truth( left.bits != 0 || right.bits != 0 );
+        case LOGICAL_AND :
+            return truth( left.bits != 0 && right.bits != 0 );
+        case PIPE :
+            return { left.bits | right.bits, is_unsigned };
+        case CARET :
+            return { left.bits ^ right.bits, is_unsigned };
+        case AMPERSAND :
+            return { left.bits & right.bits, is_unsigned };
+        case COMPARISON_EQUALS :
+            return truth( left.bits == right.bits );
+        case COMPARISON_NOT :
+            return truth( left.bits != right.bits );
+        case LESS :
+            return truth( is_unsigned ? left.bits < right.bits : l < r );
+        case GREATER :
+            return truth( is_unsigned ? left.bits > right.bits : l > r );
+        case LESS_EQUALS :
+            return truth( is_unsigned ? left.bits <= right.bits : l <= r );
+        case GREATER_EQUALS :
+            return truth( is_unsigned ? left.bits >= right.bits : l >= r );
+        case LEFT_SHIFT :
+        case RIGHT_SHIFT :
+            return shift( op, left, right );
+        case PLUS :
+            if ( is_unsigned ) {
+                return { left.bits + right.bits, true };
+            }
+            return __builtin_add_overflow( l, r, &result ) ? failed( "Overflow in #if" ) : signed_value( result );
+        case DASH :
+            if ( is_unsigned ) {
+                return { left.bits - right.bits, true };
+            }
+            return __builtin_sub_overflow( l, r, &result ) ? failed( "Overflow in #if" ) : signed_value( result );
+        case ASTÉRIX :
+            if ( is_unsigned ) {
+                return { left.bits * right.bits, true };
+            }
+            return __builtin_mul_overflow( l, r, &result ) ? failed( "Overflow in #if" ) : signed_value( result );
+        case SLASH :
+        case PERCENT :
+            if ( right.bits == 0 ) {
+                return failed( "Division by zero in #if" );
+            }
+            if ( is_unsigned ) {
+                return { op == SLASH ? left.bits / right.bits : left.bits % right.bits, true };
+            }
+            if ( l == std::numeric_limits<std::intmax_t>::min() && r == -1 ) {
+                return failed( "Overflow in #if" );
+            }
+            return signed_value( op == SLASH ? l / r : l % r );
+        default :
+            return {};
+        }
+    }
+
+    // The type is that of the left operand, and the count must be less than its width.
+    [[nodiscard]] IfValue shift( TokenType const op, IfValue const left, IfValue const right ) const {
+        constexpr auto width = std::numeric_limits<std::uintmax_t>::digits;
+        if ( ( !right.is_unsigned && right.as_signed() < 0 ) || right.bits >= width ) {
+            auto const count = right.is_unsigned ? std::to_string( right.bits ) : std::to_string( right.as_signed() );
+            return failed( std::format( "Shift by {} in #if", count ) );
+        }
+        if ( left.is_unsigned ) {
+            return { op == TokenType::LEFT_SHIFT ? left.bits << right.bits : left.bits >> right.bits, true };
+        }
+        auto const l = left.as_signed();
+        if ( op == TokenType::RIGHT_SHIFT ) {
+            return signed_value( l >> right.bits );
+        }
+        if ( l < 0 || l > ( std::numeric_limits<std::intmax_t>::max() >> right.bits ) ) {
+            return failed( "Overflow in #if" );
+        }
+        return signed_value( l << right.bits );
+    }
+
+    IfValue unary() {
+        auto const& token = next < tokens.size() ? tokens[ next ] : Token { TokenType::Eof, location };
+        ++next;
+        switch ( token.tok ) {
+            using enum TokenType;
+        case EXCLAMATION :
+            return truth( unary().bits == 0 );
+        case TILDE : {
+            auto const value = unary();
+            return { ~value.bits, value.is_unsigned };
+        }
+        case DASH : {
+            auto const value = unary();
+            if ( value.is_unsigned ) {
+                return { 0 - value.bits, true };
+            }
+            if ( value.as_signed() == std::numeric_limits<std::intmax_t>::min() ) {
+                return failed( "Overflow in #if" );
+            }
+            return signed_value( -value.as_signed() );
+        }
+        case PLUS :
+            return unary();
+        case L_PAREN : {
+            auto const value = conditional();
+            expect( R_PAREN );
+            return value;
+        }
+        case CONSTANT :
+        case LONGLITERAL :
+            return { token.number, token.number > std::uintmax_t { std::numeric_limits<std::intmax_t>::max() } };
+        default :
+            throw PreprocessorException( location, "Unexpected {} in #if", spelling( token ) );
+        }
+    }
+
+    std::vector<Token> const& tokens;
+    size_t                    next { 0 };
+    size_t                    unevaluated { 0 }; // depth of operands which are not evaluated
+    Location                  location;
+};
+
+} // namespace
+
+Preprocessor::Preprocessor( std::string_view const source, CompilationContext& context )
+    : context( context ), last_location( 1, 1 ) {
+    sources.push_back( { std::make_shared<LexedFile const>( lex_file( source ) ), 0, context.option.input_file } );
+    for ( auto const& definition : context.option.defines ) {
+        define( definition );
+    }
+    if ( context.option.prelude ) {
+        once.insert( context.option.prelude->source ); // its declarations are in the symbol table
+    }
+}
+
+Preprocessor::Preprocessor( std::istream const& source, CompilationContext& context )
+    : Preprocessor( std::string( std::istreambuf_iterator<char>( source.rdbuf() ), std::istreambuf_iterator<char>() ),
+                    context ) {}
+
+Location Preprocessor::get_location() const {
+    return last_location;
+}
+
+void Preprocessor::define( std::string const& definition ) {
+    auto const         equals = definition.find( '=' );
+    auto const         name = definition.substr( 0, equals );
+    auto const         text = name + " " + ( equals == std::string::npos ? "1" : definition.substr( equals + 1 ) );
+    Lexer              lexer( text );
+    std::vector<Token> line;
+    for ( auto token = lexer.get_token(); token.tok != TokenType::Eof; token = lexer.get_token() ) {
+        line.push_back( token );
+    }
+    define( line, name.contains( '(' ) );
+}
+
+Token Preprocessor::make_token() {
+    try {
+        while ( true ) {
+            auto token = *take( pending, true );
+            if ( !expand( token, pending, true ) ) {
+                return token.token;
+            }
+        }
+    } catch ( Exception& e ) {
+        // Name the included file the error is in.
+        if ( sources.size() > 1 && e.get_file().empty() ) {
+            e.set_file( sources.back().path.string() );
+        }
+        throw;
+    }
+}
+
+Preprocessor::MacroToken Preprocessor::read_raw() {
+    while ( true ) {
+        auto& source = sources.back();
+        if ( skipping() ) {
+            skip_to_directive( source );
+        }
+        auto const& [ token, line_start, _ ] = read( source );
+        if ( token.tok == TokenType::Eof ) {
+            if ( conditions.size() > source.conditions ) {
+                throw PreprocessorException( token.location, "Missing #endif" );
+            }
+            if ( sources.size() == 1 ) {
+                return { token, {} };
+            }
+            sources.pop_back();
+            continue;
+        }
+        if ( token.tok == TokenType::HASH && line_start ) {
+            directive( source, token );
+            continue;
+        }
+        return { token, {} };
+    }
+}
+
+std::optional<Preprocessor::MacroToken> Preprocessor::take( Tokens& input, bool const raw ) {
+    if ( !input.empty() ) {
+        auto token = std::move( input.front() );
+        input.pop_front();
+        return token;
+    }
+    if ( raw ) {
+        return read_raw();
+    }
+    return std::nullopt;
+}
+
+bool Preprocessor::expand( MacroToken const& token, Tokens& input, bool const raw ) {
+    auto const& name = token.token.value;
+    if ( token.token.tok != TokenType::IDENTIFIER || token.hidden.contains( name ) ) {
+        return false;
+    }
+    auto const found = macros.find( name );
+    if ( found == macros.end() ) {
+        return false;
+    }
+    auto const macro = found->second; // a directive read with the arguments can change the macros
+    auto       hidden = token.hidden;
+    hidden.insert( name );
+
+    std::vector<Tokens> args;
+    if ( macro.function_like ) {
+        // Without arguments the name is not a use of the macro.
+        auto next = take( input, raw );
+        if ( !next || next->token.tok != TokenType::L_PAREN ) {
+            if ( next ) {
+                input.push_front( std::move( *next ) );
+            }
+            return false;
+        }
+
+        args.emplace_back();
+        int depth = 0;
+        while ( true ) {
+            next = take( input, raw );
+            if ( !next || next->token.tok == TokenType::Eof ) {
+                throw PreprocessorException( token.token.location, "Unterminated use of macro {}", name );
+            }
+            auto const t = next->token.tok;
+            if ( t == TokenType::R_PAREN && depth == 0 ) {
+                break;
+            }
+            if ( t == TokenType::COMMA && depth == 0 ) {
+                args.emplace_back();
+                continue;
+            }
+            depth += t == TokenType::L_PAREN ? 1 : t == TokenType::R_PAREN ? -1 : 0;
+            args.back().push_back( std::move( *next ) );
+        }
+        if ( macro.params.empty() && args.size() == 1 && args.front().empty() ) {
+            args.clear();
+        }
+        if ( args.size() != macro.params.size() ) {
+            throw PreprocessorException( token.token.location, "Macro {} takes {} arguments, given {}", name,
+                                         macro.params.size(), args.size() );
+        }
+    }
+
+    auto const result = substitute( macro, args, hidden, token.token.location );
+    input.insert( input.begin(), result.begin(), result.end() );
+    return true;
+}
+
+Preprocessor::Tokens Preprocessor::expand_all( Tokens input ) {
+    Tokens output;
+    while ( auto token = take( input, false ) ) {
+        if ( !expand( *token, input, false ) ) {
+            output.push_back( std::move( *token ) );
+        }
+    }
+    return output;
+}
+
+Preprocessor::Tokens Preprocessor::substitute( Macro const& macro, std::vector<Tokens> const& args,
+                                               std::set<std::string> const& hidden, Location const location ) {
+    auto const param = [ &macro ]( Token const& token ) -> std::optional<size_t> {
+        if ( token.tok != TokenType::IDENTIFIER ) {
+            return std::nullopt;
+        }
+        auto const found = std::ranges::find( macro.params, token.value );
+        if ( found == macro.params.end() ) {
+            return std::nullopt;
+        }
+        return found - macro.params.begin();
+    };
+
+    Tokens result;
+    bool   paste_next = false;
+    for ( size_t i = 0; i < macro.body.size(); ++i ) {
+        auto const& token = macro.body[ i ];
+        if ( token.tok == TokenType::HASH_HASH ) {
+            paste_next = true;
+            continue;
+        }
+
+        // Arguments are expanded, unless they are pasted.
+        Tokens     operand;
+        bool const paste_before = i + 1 < macro.body.size() && macro.body[ i + 1 ].tok == TokenType::HASH_HASH;
+        if ( auto const index = param( token ) ) {
+            operand = paste_next || paste_before ? args[ *index ] : expand_all( args[ *index ] );
+        } else {
+            operand.push_back( { token, {} } );
+        }
+
+        if ( paste_next && !result.empty() && !operand.empty() ) {
+            auto left = std::move( result.back() );
+            result.pop_back();
+            left.token = paste( left.token, operand.front().token );
+            result.push_back( std::move( left ) );
+            operand.pop_front();
+        }
+        paste_next = false;
+        std::ranges::move( operand, std::back_inserter( result ) );
+    }
+
+    for ( auto& token : result ) {
+        token.token.location = location;
+        token.hidden.insert( hidden.begin(), hidden.end() );
+    }
+    return result;
+}
+
+Token Preprocessor::paste( Token const& left, Token const& right ) const {
+    auto const text = spelling( left ) + spelling( right );
+    Lexer      lexer( text );
+    auto       token = lexer.get_token();
+    if ( token.tok == TokenType::Eof || lexer.get_token().tok != TokenType::Eof ) {
+        throw PreprocessorException( left.location, "Pasting {} and {} does not give a token", spelling( left ),
+                                     spelling( right ) );
+    }
+    return token;
+}
+
+LexedFile::Entry const& Preprocessor::read( Source& source ) {
+    auto const& entry = source.file->tokens[ source.next ];
+    if ( entry.token.tok == TokenType::Null ) {
+        throw LexicalException( entry.token.value );
+    }
+    if ( entry.token.tok != TokenType::Eof ) {
+        ++source.next;
+    }
+    last_location = entry.token.location;
+    return entry;
+}
+
+bool Preprocessor::end_of_line( Source const& source ) {
+    auto const& entry = source.file->tokens[ source.next ];
+    return entry.line_start || entry.token.tok == TokenType::Eof;
+}
+
+void Preprocessor::skip_to_directive( Source& source ) {
+    auto const& tokens = source.file->tokens;
+    while ( tokens[ source.next ].token.tok != TokenType::Eof &&
+            !( tokens[ source.next ].line_start && tokens[ source.next ].token.tok == TokenType::HASH ) ) {
+        ++source.next;
+    }
+}
+
+std::vector<Token> Preprocessor::rest_of_line( Source& source ) {
+    std::vector<Token> line;
+    while ( !end_of_line( source ) ) {
+        line.push_back( read( source ).token );
+    }
+    return line;
+}
+
+void Preprocessor::directive( Source& source, Token const& hash ) {
+    if ( end_of_line( source ) ) {
+        return; // null directive
+    }
+    auto const name = spelling( read( source ).token );
+
+    // Conditionals are followed when skipping lines, the other directives are not. The rest of a line which is
+    // skipped is not read, as it need not be made of tokens.
+    if ( name == "if" || name == "ifdef" || name == "ifndef" ) {
+        if ( skipping() ) {
+            conditions.push_back( { .active = false, .taken = true } );
+            return;
+        }
+        bool value;
+        auto line = rest_of_line( source );
+        if ( name == "if" ) {
+            value = evaluate( line, hash.location );
+        } else {
+            if ( line.size() != 1 || line.front().tok != TokenType::IDENTIFIER ) {
+                throw PreprocessorException( hash.location, "#{} takes a macro name", name );
+            }
+            value = macros.contains( line.front().value ) == ( name == "ifdef" );
+        }
+        conditions.push_back( { .active = value, .taken = value } );
+        return;
+    }
+    if ( name == "elif" || name == "else" || name == "endif" ) {
+        if ( conditions.size() <= source.conditions ) {
+            throw PreprocessorException( hash.location, "#{} without #if", name );
+        }
+        auto& condition = conditions.back();
+        if ( name == "endif" ) {
+            conditions.pop_back();
+            if ( !skipping() ) {
+                rest_of_line( source );
+            }
+            return;
+        }
+        if ( condition.had_else ) {
+            throw PreprocessorException( hash.location, "#{} after #else", name );
+        }
+        if ( name == "else" ) {
+            condition.had_else = true;
+            condition.active = !condition.taken;
+            if ( condition.active ) {
+                rest_of_line( source );
+            }
+        } else if ( condition.taken ) {
+            condition.active = false;
+        } else {
+            condition.active = evaluate( rest_of_line( source ), hash.location );
+        }
+        condition.taken = condition.taken || condition.active;
+        return;
+    }
+    if ( skipping() ) {
+        return;
+    }
+
+    if ( name == "define" ) {
+        if ( end_of_line( source ) ) {
+            throw PreprocessorException( hash.location, "#define without a macro name" );
+        }
+        auto const& [ macro_name, _, function_like ] = read( source );
+        auto        line = rest_of_line( source );
+        line.insert( line.begin(), macro_name );
+        define( line, function_like );
+    } else if ( name == "undef" ) {
+        auto const line = rest_of_line( source );
+        if ( line.size() != 1 || line.front().tok != TokenType::IDENTIFIER ) {
+            throw PreprocessorException( hash.location, "#undef takes a macro name" );
+        }
+        macros.erase( line.front().value );
+    } else if ( name == "include" ) {
+        include( source, hash.location );
+    } else if ( name == "error" ) {
+        std::string message;
+        for ( auto const& token : rest_of_line( source ) ) {
+            message += ( message.empty() ? "" : " " ) + spelling( token );
+        }
+        throw PreprocessorException( hash.location, "#error {}", message );
+    } else if ( name == "pragma" ) {
+        auto const line = rest_of_line( source );
+        if ( line.size() == 1 && line.front().tok == TokenType::IDENTIFIER && line.front().value == "once" ) {
+            once.insert( std::filesystem::weakly_canonical( source.path ).string() );
+        }
+    } else if ( name == "line" ) {
+        rest_of_line( source );
+    } else {
+        throw PreprocessorException( hash.location, "Unknown directive #{}", name );
+    }
+}
+
+void Preprocessor::define( std::vector<Token> const& line, bool const function_like ) {
+    if ( line.empty() || line.front().tok != TokenType::IDENTIFIER ) {
+        throw PreprocessorException( line.empty() ? Location {} : line.front().location,
+                                     "Macro name must be an identifier" );
+    }
+    auto const& name = line.front();
+    Macro       macro { .function_like = function_like };
+    size_t      i = 1;
+    if ( function_like ) {
+        // Parameters: ( name, ... )
+        for ( i = 2; i < line.size() && line[ i ].tok != TokenType::R_PAREN; ++i ) {
+            if ( line[ i ].tok != TokenType::IDENTIFIER ) {
+                throw PreprocessorException( name.location, "Bad parameter {} for macro {}", spelling( line[ i ] ),
+                                             name.value );
+            }
+            macro.params.push_back( line[ i ].value );
+            if ( i + 1 < line.size() && line[ i + 1 ].tok == TokenType::COMMA ) {
+                ++i;
+            }
+        }
+        if ( i == line.size() ) {
+            throw PreprocessorException( name.location, "Missing ) in parameters of macro {}", name.value );
+        }
+        ++i;
+    }
+    macro.body.assign( line.begin() + static_cast<std::ptrdiff_t>( i ), line.end() );
+
+    if ( !macro.body.empty() &&
+         ( macro.body.front().tok == TokenType::HASH_HASH || macro.body.back().tok == TokenType::HASH_HASH ) ) {
+        throw PreprocessorException( name.location, "## at the edge of macro {}", name.value );
+    }
+    auto const is_hash = []( Token const& t ) { return t.tok == TokenType::HASH; };
+    if ( function_like && std::ranges::any_of( macro.body, is_hash ) ) {
+        throw PreprocessorException( name.location, "# is not supported in macro {}", name.value );
+    }
+    macros[ name.value ] = std::move( macro );
+}
+
+void Preprocessor::include( Source& source, Location const location ) {
+    auto const header = end_of_line( source ) ? Token {} : read( source ).token;
+    if ( header.tok != TokenType::HEADER_NAME ) {
+        throw PreprocessorException( location, "#include takes \"file\" or <file>" );
+    }
+    if ( !end_of_line( source ) ) {
+        throw PreprocessorException( location, "Extra tokens after #include {}", header.value );
+    }
+    auto const name = header.value.substr( 1, header.value.size() - 2 );
+
+    // "file" is looked for next to the file including it, then in the -I directories, then <file> in the system's.
+    std::vector<std::filesystem::path> directories;
+    if ( header.value.front() == '"' ) {
+        directories.push_back( source.path.parent_path() );
+    }
+    directories.insert( directories.end(), context.option.include_paths.begin(), context.option.include_paths.end() );
+    if ( header.value.front() == '<' ) {
+        directories.emplace_back( "/usr/local/include" );
+        directories.emplace_back( "/usr/include" );
+    }
+    auto const found = std::ranges::find_if( directories, [ &name ]( auto const& directory ) {
+        return std::filesystem::is_regular_file( directory / name );
+    } );
+    if ( found == directories.end() ) {
+        throw PreprocessorException( location, "Cannot find #include {}", header.value );
+    }
+    if ( sources.size() >= max_include_depth ) {
+        throw PreprocessorException( location, "#include nested too deeply" );
+    }
+
+    // A file is skipped if it has been included before with #pragma once, or its include guard is defined.
+    auto const path = *found / name;
+    auto const key = std::filesystem::weakly_canonical( path ).string();
+    if ( once.contains( key ) ) {
+        context.logger->debug( "include {} skipped, #pragma once", path.string() );
+        return;
+    }
+    if ( auto const guard = guards.find( key ); guard != guards.end() && macros.contains( guard->second ) ) {
+        context.logger->debug( "include {} skipped, guarded by {}", path.string(), guard->second );
+        return;
+    }
+
+    std::shared_ptr<LexedFile const> file;
+    try {
+        file = context.option.include_cache ? context.option.include_cache->get( path ) : lex_file( path );
+    } catch ( const std::exception& err ) {
+        throw PreprocessorException( location, "Cannot read #include {}: {}", header.value, err.what() );
+    }
+    if ( file->guard ) {
+        guards[ key ] = *file->guard;
+    }
+    context.logger->debug( "include {}", path.string() );
+    context.included_files.push_back( path.string() );
+    sources.push_back( { std::move( file ), 0, path, conditions.size() } );
+}
+
+bool Preprocessor::evaluate( std::vector<Token> const& line, Location const location ) {
+    if ( line.empty() ) {
+        throw PreprocessorException( location, "#if without an expression" );
+    }
+
+    // defined name and defined( name ) are replaced before expanding macros.
+    Tokens tokens;
+    for ( size_t i = 0; i < line.size(); ++i ) {
+        if ( line[ i ].tok == TokenType::IDENTIFIER && line[ i ].value == "defined" ) {
+            bool const   paren = i + 1 < line.size() && line[ i + 1 ].tok == TokenType::L_PAREN;
+            size_t const n = i + 1 + ( paren ? 1 : 0 );
+            if ( n >= line.size() || line[ n ].tok != TokenType::IDENTIFIER ||
+                 ( paren && ( n + 1 >= line.size() || line[ n + 1 ].tok != TokenType::R_PAREN ) ) ) {
+                throw PreprocessorException( location, "defined takes a macro name" );
+            }
+            bool const defined = macros.contains( line[ n ].value );
+            tokens.push_back(
+                { { TokenType::CONSTANT, line[ i ].location, defined ? "1" : "0", defined ? 1U : 0U }, {} } );
+            i = n + ( paren ? 1 : 0 );
+            continue;
+        }
+        tokens.push_back( { line[ i ], {} } );
+    }
+
+    // Names left after expansion are 0.
+    std::vector<Token> expression;
+    for ( auto& token : expand_all( std::move( tokens ) ) ) {
+        if ( token.token.tok == TokenType::IDENTIFIER ) {
+            token.token = { TokenType::CONSTANT, token.token.location, "0", 0 };
+        }
+        expression.push_back( std::move( token.token ) );
+    }
+    return IfExpression( expression, location ).evaluate().bits != 0;
+}
@@ -0,0 +1,103 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <deque>
+#include <filesystem>
+#include <istream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "compilationContext.h"
+#include "includeCache.h"
+#include "lexer.h"
+
+// The C preprocessor, between the lexer and the parser. Handles #include, object and function-like macros (without
+// # stringising, as there are no string literals), and the conditionals #if, #ifdef, #ifndef, #elif, #else and
+// #endif. Works on the tokens of the lexer, so the tokens keep their locations in their own file, and tokens from a
+// macro have the location of the macro where it is used. Included files come from option.include_cache when set, and
+// a file with an include guard or #pragma once is not read again once it has been included. The file of the prelude
+// in the options is not read at all.
+class Preprocessor : public TokenStream {
+  public:
+    // The source is the file option.input_file, which is used to find the files it includes. It is lexed when the
+    // preprocessor is made, and not kept.
+    Preprocessor( std::string_view source, CompilationContext& context );
+    Preprocessor( std::istream const& source, CompilationContext& context );
+    ~Preprocessor() override = default;
+
+    [[nodiscard]] Location get_location() const override;
+
+    // -D: name or name=value
+    void define( std::string const& definition );
+
+  protected:
+    Token make_token() override;
+
+  private:
+    struct Macro {
+        bool                     function_like { false };
+        std::vector<std::string> params;
+        std::vector<Token>       body;
+    };
+
+    // A token with the names of the macros it was expanded from, which are not expanded again in it.
+    struct MacroToken {
+        Token                 token;
+        std::set<std::string> hidden;
+    };
+    using Tokens = std::deque<MacroToken>;
+
+    struct Source {
+        std::shared_ptr<LexedFile const> file;
+        size_t                           next { 0 }; // next token in the file
+        std::filesystem::path            path;
+        size_t                           conditions { 0 }; // open conditionals when the file was included
+    };
+
+    struct Condition {
+        bool active { true };    // the lines in it are compiled
+        bool taken { false };    // a branch has been compiled
+        bool had_else { false }; // the #else has been seen
+    };
+
+    MacroToken                read_raw();
+    std::optional<MacroToken> take( Tokens& input, bool raw );
+    bool                      expand( MacroToken const& token, Tokens& input, bool raw );
+    Tokens                    expand_all( Tokens input );
+    Tokens                    substitute( Macro const& macro, std::vector<Tokens> const& args,
+                                          std::set<std::string> const& hidden, Location location );
+    Token                     paste( Token const& left, Token const& right ) const;
+
+    LexedFile::Entry const& read( Source& source );
+    static bool        end_of_line( Source const& source );
+    static void        skip_to_directive( Source& source );
+    void               directive( Source& source, Token const& hash );
+    std::vector<Token> rest_of_line( Source& source );
+    void               define( std::vector<Token> const& line, bool function_like );
+    void               include( Source& source, Location location );
+    bool               evaluate( std::vector<Token> const& line, Location location );
+    [[nodiscard]] bool skipping() const { return !conditions.empty() && !conditions.back().active; }
+
+    CompilationContext&                context;
+    std::vector<Source>                sources; // the file being read is last
+    std::vector<Condition>             conditions;
+    std::map<std::string, Macro>       macros;
+    Tokens                             pending;       // tokens from macros, read before the sources
+    std::set<std::string>              once;          // files with #pragma once, and the prelude
+    std::map<std::string, std::string> guards;        // include guards of the files included
+    Location                           last_location; // of the last token read
+};
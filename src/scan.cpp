@@ -0,0 +1,305 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "scan.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#if defined( __x86_64__ )
+#include <immintrin.h>
+#endif
+
+namespace scan {
+
+namespace {
+
+// Plain C++, for the other processors and for the bytes after the last whole block.
+
+constexpr bool is_blank( char const c ) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+constexpr bool is_digit( char const c ) {
+    return c >= '0' && c <= '9';
+}
+
+constexpr bool is_identifier( char const c ) {
+    return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || is_digit( c ) || c == '_';
+}
+
+char const* skip_blanks_scalar( char const* p, char const* const end ) {
+    while ( p != end && is_blank( *p ) ) {
+        ++p;
+    }
+    return p;
+}
+
+char const* find_newline_scalar( char const* p, char const* const end ) {
+    while ( p != end && *p != '\n' ) {
+        ++p;
+    }
+    return p;
+}
+
+char const* find_comment_end_scalar( char const* p, char const* const end ) {
+    while ( end - p >= 2 ) {
+        if ( p[ 0 ] == '*' && p[ 1 ] == '/' ) {
+            return p;
+        }
+        ++p;
+    }
+    return end;
+}
+
+char const* skip_identifier_scalar( char const* p, char const* const end ) {
+    while ( p != end && is_identifier( *p ) ) {
+        ++p;
+    }
+    return p;
+}
+
+char const* skip_digits_scalar( char const* p, char const* const end ) {
+    while ( p != end && is_digit( *p ) ) {
+        ++p;
+    }
+    return p;
+}
+
+std::size_t count_newlines_scalar( char const* const p, char const* const end ) {
+    return static_cast<std::size_t>( std::count( p, end, '\n' ) );
+}
+
+constexpr Scanner scalar { "scalar",
+                           skip_blanks_scalar,
+                           find_newline_scalar,
+                           find_comment_end_scalar,
+                           skip_identifier_scalar,
+                           skip_digits_scalar,
+                           count_newlines_scalar };
+
+#if defined( __x86_64__ )
+
+// SSE2, which every x86_64 has. A mask has a bit for each byte of the block which stops the scan.
+
+__m128i load_sse2( char const* p ) {
+    return _mm_loadu_si128( reinterpret_cast<__m128i const*>( p ) );
+}
+
+// Bytes from lo to hi. Bytes of 0x80 and above are negative, so are never in an ASCII range.
+__m128i in_range_sse2( __m128i const block, char const lo, char const hi ) {
+    return _mm_and_si128( _mm_cmpgt_epi8( block, _mm_set1_epi8( static_cast<char>( lo - 1 ) ) ),
+                          _mm_cmpgt_epi8( _mm_set1_epi8( static_cast<char>( hi + 1 ) ), block ) );
+}
+
+std::uint32_t all_sse2( __m128i const matches ) {
+    return static_cast<std::uint32_t>( _mm_movemask_epi8( matches ) );
+}
+
+std::uint32_t not_sse2( __m128i const matches ) {
+    return ~all_sse2( matches ) & 0xFFFF;
+}
+
+char const* skip_blanks_sse2( char const* p, char const* const end ) {
+    for ( ; end - p >= 16; p += 16 ) {
+        auto const block = load_sse2( p );
+        auto const blank = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( block, _mm_set1_epi8( ' ' ) ),
+                                                       _mm_cmpeq_epi8( block, _mm_set1_epi8( '\t' ) ) ),
+                                         _mm_cmpeq_epi8( block, _mm_set1_epi8( '\r' ) ) );
+        if ( auto const stop = not_sse2( blank ) ) {
+            return p + std::countr_zero( stop );
+        }
+    }
+    return skip_blanks_scalar( p, end );
+}
+
+char const* find_newline_sse2( char const* p, char const* const end ) {
+    for ( ; end - p >= 16; p += 16 ) {
+        if ( auto const stop = all_sse2( _mm_cmpeq_epi8( load_sse2( p ), _mm_set1_epi8( '\n' ) ) ) ) {
+            return p + std::countr_zero( stop );
+        }
+    }
+    return find_newline_scalar( p, end );
+}
+
+char const* find_comment_end_sse2( char const* p, char const* const end ) {
+    // A * in the block followed by a / in the block one byte on.
+    for ( ; end - p >= 17; p += 16 ) {
+        auto const star = _mm_cmpeq_epi8( load_sse2( p ), _mm_set1_epi8( '*' ) );
+        auto const slash = _mm_cmpeq_epi8( load_sse2( p + 1 ), _mm_set1_epi8( '/' ) );
+        if ( auto const stop = all_sse2( _mm_and_si128( star, slash ) ) ) {
+            return p + std::countr_zero( stop );
+        }
+    }
+    return find_comment_end_scalar( p, end );
+}
+
+char const* skip_identifier_sse2( char const* p, char const* const end ) {
+    for ( ; end - p >= 16; p += 16 ) {
+        auto const block = load_sse2( p );
+        auto const letter = in_range_sse2( _mm_or_si128( block, _mm_set1_epi8( 0x20 ) ), 'a', 'z' ); // either case
+        auto const identifier = _mm_or_si128( _mm_or_si128( letter, in_range_sse2( block, '0', '9' ) ),
+                                              _mm_cmpeq_epi8( block, _mm_set1_epi8( '_' ) ) );
+        if ( auto const stop = not_sse2( identifier ) ) {
+            return p + std::countr_zero( stop );
+        }
+    }
+    return skip_identifier_scalar( p, end );
+}
+
+char const* skip_digits_sse2( char const* p, char const* const end ) {
+    for ( ; end - p >= 16; p += 16 ) {
+        if ( auto const stop = not_sse2( in_range_sse2( load_sse2( p ), '0', '9' ) ) ) {
+            return p + std::countr_zero( stop );
+        }
+    }
+    return skip_digits_scalar( p, end );
+}
+
+std::size_t count_newlines_sse2( char const* p, char const* const end ) {
+    std::size_t count = 0;
+    for ( ; end - p >= 16; p += 16 ) {
+        count += std::popcount( all_sse2( _mm_cmpeq_epi8( load_sse2( p ), _mm_set1_epi8( '\n' ) ) ) );
+    }
+    return count + count_newlines_scalar( p, end );
+}
+
+constexpr Scanner sse2 { "sse2",
+                         skip_blanks_sse2,
+                         find_newline_sse2,
+                         find_comment_end_sse2,
+                         skip_identifier_sse2,
+                         skip_digits_sse2,
+                         count_newlines_sse2 };
+
+// AVX2, the same 32 bytes at a time, compiled for AVX2 whatever the target of the rest of the compiler. Each clears the
+// upper halves of the registers before it returns, as the SSE code after it is slow until they are.
+
+[[gnu::target( "avx2" )]] __m256i load_avx2( char const* p ) {
+    return _mm256_loadu_si256( reinterpret_cast<__m256i const*>( p ) );
+}
+
+[[gnu::target( "avx2" )]] __m256i in_range_avx2( __m256i const block, char const lo, char const hi ) {
+    return _mm256_and_si256( _mm256_cmpgt_epi8( block, _mm256_set1_epi8( static_cast<char>( lo - 1 ) ) ),
+                             _mm256_cmpgt_epi8( _mm256_set1_epi8( static_cast<char>( hi + 1 ) ), block ) );
+}
+
+[[gnu::target( "avx2" )]] std::uint32_t all_avx2( __m256i const matches ) {
+    return static_cast<std::uint32_t>( _mm256_movemask_epi8( matches ) );
+}
+
+[[gnu::target( "avx2" )]] std::uint32_t not_avx2( __m256i const matches ) {
+    return ~all_avx2( matches );
+}
+
+[[gnu::target( "avx2" )]] char const* skip_blanks_avx2( char const* p, char const* const end ) {
+    char const* found = nullptr;
+    for ( ; !found && end - p >= 32; p += 32 ) {
+        auto const block = load_avx2( p );
+        auto const blank = _mm256_or_si256( _mm256_or_si256( _mm256_cmpeq_epi8( block, _mm256_set1_epi8( ' ' ) ),
+                                                             _mm256_cmpeq_epi8( block, _mm256_set1_epi8( '\t' ) ) ),
+                                            _mm256_cmpeq_epi8( block, _mm256_set1_epi8( '\r' ) ) );
+        if ( auto const stop = not_avx2( blank ) ) {
+            found = p + std::countr_zero( stop );
+        }
+    }
+    _mm256_zeroupper();
+    return found ? found : skip_blanks_sse2( p, end );
+}
+
+[[gnu::target( "avx2" )]] char const* find_newline_avx2( char const* p, char const* const end ) {
+    char const* found = nullptr;
+    for ( ; !found && end - p >= 32; p += 32 ) {
+        if ( auto const stop = all_avx2( _mm256_cmpeq_epi8( load_avx2( p ), _mm256_set1_epi8( '\n' ) ) ) ) {
+            found = p + std::countr_zero( stop );
+        }
+    }
+    _mm256_zeroupper();
+    return found ? found : find_newline_sse2( p, end );
+}
+
+[[gnu::target( "avx2" )]] char const* find_comment_end_avx2( char const* p, char const* const end ) {
+    char const* found = nullptr;
+    for ( ; !found && end - p >= 33; p += 32 ) {
+        auto const star = _mm256_cmpeq_epi8( load_avx2( p ), _mm256_set1_epi8( '*' ) );
+        auto const slash = _mm256_cmpeq_epi8( load_avx2( p + 1 ), _mm256_set1_epi8( '/' ) );
+        if ( auto const stop = all_avx2( _mm256_and_si256( star, slash ) ) ) {
+            found = p + std::countr_zero( stop );
+        }
+    }
+    _mm256_zeroupper();
+    return found ? found : find_comment_end_sse2( p, end );
+}
+
+[[gnu::target( "avx2" )]] char const* skip_identifier_avx2( char const* p, char const* const end ) {
+    char const* found = nullptr;
+    for ( ; !found && end - p >= 32; p += 32 ) {
+        auto const block = load_avx2( p );
+        auto const letter = in_range_avx2( _mm256_or_si256( block, _mm256_set1_epi8( 0x20 ) ), 'a', 'z' );
+        auto const identifier = _mm256_or_si256( _mm256_or_si256( letter, in_range_avx2( block, '0', '9' ) ),
+                                                 _mm256_cmpeq_epi8( block, _mm256_set1_epi8( '_' ) ) );
+        if ( auto const stop = not_avx2( identifier ) ) {
+            found = p + std::countr_zero( stop );
+        }
+    }
+    _mm256_zeroupper();
+    return found ? found : skip_identifier_sse2( p, end );
+}
+
+[[gnu::target( "avx2" )]] char const* skip_digits_avx2( char const* p, char const* const end ) {
+    char const* found = nullptr;
+    for ( ; !found && end - p >= 32; p += 32 ) {
+        if ( auto const stop = not_avx2( in_range_avx2( load_avx2( p ), '0', '9' ) ) ) {
+            found = p + std::countr_zero( stop );
+        }
+    }
+    _mm256_zeroupper();
+    return found ? found : skip_digits_sse2( p, end );
+}
+
+[[gnu::target( "avx2" )]] std::size_t count_newlines_avx2( char const* p, char const* const end ) {
+    std::size_t count = 0;
+    for ( ; end - p >= 32; p += 32 ) {
+        count += std::popcount( all_avx2( _mm256_cmpeq_epi8( load_avx2( p ), _mm256_set1_epi8( '\n' ) ) ) );
+    }
+    _mm256_zeroupper();
+    return count + count_newlines_sse2( p, end );
+}
+
+constexpr Scanner avx2 { "avx2",
+                         skip_blanks_avx2,
+                         find_newline_avx2,
+                         find_comment_end_avx2,
+                         skip_identifier_avx2,
+                         skip_digits_avx2,
+                         count_newlines_avx2 };
+
+#endif
+
+} // namespace
+
+Scanner const& best() {
+    static Scanner const& chosen = *supported().back();
+    return chosen;
+}
+
+std::vector<Scanner const*> supported() {
+    std::vector<Scanner const*> result { &scalar };
+#if defined( __x86_64__ )
+    result.push_back( &sse2 );
+    if ( __builtin_cpu_supports( "avx2" ) ) {
+        result.push_back( &avx2 );
+    }
+#endif
+    return result;
+}
+
+} // namespace scan
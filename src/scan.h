@@ -0,0 +1,37 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// The loops of the lexer which run over many characters, with SSE2 and AVX2 versions on x86_64 which look at 16 or 32
+// bytes at a time. Each takes the text from p up to end, and returns where the run stops, which is end if it does not
+// stop, or for count_newlines how many \n there are. Only ASCII letters and digits are in identifiers, as with std::isalnum in the C locale.
+namespace scan {
+
+struct Scanner {
+    char const* name;
+    char const* ( *skip_blanks )( char const* p, char const* end );      // spaces, tabs and carriage returns
+    char const* ( *find_newline )( char const* p, char const* end );     // the next \n
+    char const* ( *find_comment_end )( char const* p, char const* end ); // the * of the next */
+    char const* ( *skip_identifier )( char const* p, char const* end );  // letters, digits and _
+    char const* ( *skip_digits )( char const* p, char const* end );
+    std::size_t ( *count_newlines )( char const* p, char const* end ); // the lines of a /* */ comment
+};
+
+// The fastest the processor supports, chosen the first time it is called.
+Scanner const& best();
+
+// The scanners the processor supports, the plain C++ one first, for testing them against each other.
+std::vector<Scanner const*> supported();
+
+} // namespace scan
@@ -13,8 +13,6 @@
 #include <algorithm>
 #include <set>
 
-#include "spdlog/spdlog.h"
-
 #include "ast/includes.h"
 #include "common.h"
 #include "enumerate.h"
@@ -31,9 +29,8 @@ std::optional<std::int64_t> get_constant( const ast::Expr ast ) {
     return std::nullopt;
 }
 
-void SemanticAnalyser::analyse( const ast::Program ast, SymbolTable& table ) {
-    global_table = &table;
-    program( ast, table );
+void SemanticAnalyser::analyse( const ast::Program ast ) {
+    program( ast, context.symbol_table );
 }
 
 void SemanticAnalyser::program( const ast::Program ast, SymbolTable& table ) {
@@ -49,7 +46,7 @@ void SemanticAnalyser::program( const ast::Program ast, SymbolTable& table ) {
 }
 
 void SemanticAnalyser::file_variable_def( ast::VariableDef ast, SymbolTable& table ) {
-    spdlog::debug( "file VariableDef: {}", ast->name );
+    context.logger->debug( "file VariableDef: {}", ast->name );
     // extern variables can't have initializers
     if ( ast->storage == StorageClass::Extern && ast->init ) {
         throw SemanticException( ast->location, "Extern variables can't have initializers" );
@@ -77,7 +74,7 @@ void SemanticAnalyser::file_variable_def( ast::VariableDef ast, SymbolTable& tab
                 throw SemanticException( ast->location,
                                          "Can't declare the same declaration with and without linkage: {}", ast->name );
             }
-            spdlog::debug( "Set tentative value {}", value );
+            context.logger->debug( "Set tentative value {}", value );
             old_decl->number = value;
             old_decl->initaliser = Initialiser::Final;
             table.put( ast->name, *old_decl );
@@ -93,9 +90,9 @@ void SemanticAnalyser::file_variable_def( ast::VariableDef ast, SymbolTable& tab
             throw SemanticException( ast->location, "Can't declare the same declaration {} with different type: {} ",
                                      ast->name, to_string( ast->var_type ) );
         }
-        spdlog::debug( "What to do with variable: {}", ast->name );
+        context.logger->debug( "What to do with variable: {}", ast->name );
     }
-    spdlog::debug( "Declaring file variable: {}", ast->name );
+    context.logger->debug( "Declaring file variable: {}", ast->name );
     auto global = ast->storage != StorageClass::Static;
     table.put( ast->name, Symbol { .name = ast->name,
                                    .storage = ast->storage,
@@ -107,7 +104,7 @@ void SemanticAnalyser::file_variable_def( ast::VariableDef ast, SymbolTable& tab
 }
 
 void SemanticAnalyser::function_def( ast::FunctionDef ast, SymbolTable& table ) {
-    spdlog::debug( "Function: {}", ast->name );
+    context.logger->debug( "Function: {}", ast->name );
     // Clear the labels for each function.
     labels.clear();
 
@@ -126,51 +123,51 @@ void SemanticAnalyser::function_def( ast::FunctionDef ast, SymbolTable& table )
 
     auto old_dec = table.find( ast->name );
     if ( old_dec ) {
-        spdlog::debug( "Symbol {} already exists", ast->name );
-        spdlog::debug( "symbol: {:s} current_scope: {}", to_string( *old_dec ), old_dec->current_scope );
+        context.logger->debug( "Symbol {} already exists", ast->name );
+        context.logger->debug( "symbol: {:s} current_scope: {}", to_string( *old_dec ), old_dec->current_scope );
 
         if ( old_dec->type != Type::FUNCTION && old_dec->global ) {
             // Another symbol is already defined with the same name, but it is not a function.
             throw SemanticException( ast->location, "Redeclaring {} as a function", ast->name );
         }
 
-        spdlog::debug( "1" );
+        context.logger->debug( "1" );
         if ( old_dec->storage == StorageClass::None && old_dec->current_scope && old_dec->global ) {
             throw SemanticException( ast->location, "Duplicate function declaration: {}", ast->name );
         }
 
-        spdlog::debug( "2" );
+        context.logger->debug( "2" );
         if ( old_dec->type != Type::FUNCTION ) {
             // Variable was declared in a another scope, discard symbol and exit this section
             old_dec = std::nullopt;
             goto out;
         }
 
-        spdlog::debug( "3" );
+        context.logger->debug( "3" );
         if ( old_dec->storage == StorageClass::Static && old_dec->current_scope ) {
             // If the function is internal, it should not be declared again.
             throw SemanticException( ast->location, "Duplicate function declaration: {}.", ast->name );
         }
 
-        spdlog::debug( "4" );
+        context.logger->debug( "4" );
         if ( ast->block && old_dec->initaliser == Initialiser::Final ) {
             // Function defined more than once
             throw SemanticException( ast->location, "Function {} already defined", ast->name );
         }
 
-        spdlog::debug( "5" );
+        context.logger->debug( "5" );
         if ( ast->storage == StorageClass::Static ) {
             throw SemanticException( ast->location, "Static function {} follows non-static", ast->name );
         }
 
-        spdlog::debug( "6" );
+        context.logger->debug( "6" );
         if ( old_dec->global && old_dec->current_scope && ast->block ) {
             throw SemanticException( ast->location, "Extern function {} follows non-extern", ast->name );
         }
 
-        spdlog::debug( "7" );
+        context.logger->debug( "7" );
         if ( ast->storage == StorageClass::Static ) {
-            spdlog::debug( "Static function {} follows non-static", ast->name );
+            context.logger->debug( "Static function {} follows non-static", ast->name );
         }
 
         global = old_dec->global;
@@ -194,8 +191,8 @@ out:
     s.function_type = function_type;
 
     // Check if the function is defined as a nested function.
-    if ( auto f = global_table->find( ast->name ) ) {
-        spdlog::debug( "Function {} is defined as a nested function", ast->name );
+    if ( auto f = context.symbol_table.find( ast->name ) ) {
+        context.logger->debug( "Function {} is defined as a nested function", ast->name );
 
         // type check it
         if ( f->number != ast->params.size() ) {
@@ -230,8 +227,8 @@ out:
 
         // Add parameters to the symbol table.
         for ( auto [ i, param ] : enumerate( ast->params ) ) {
-            auto unique_name = table.temp_name( param );
-            spdlog::debug( "Declaring param: {} as {}", param, unique_name );
+            auto unique_name = context.names.temp_name( param );
+            context.logger->debug( "Declaring param: {} as {}", param, unique_name );
             new_table.put( param, Symbol { .name = unique_name,
                                            .storage = StorageClass::Parameter,
                                            .type = ast->function_type.parameter_types[ i ],
@@ -243,12 +240,12 @@ out:
         visit_Compound( ast->block.value(), new_table );
     } else {
         // If there is no block, it is a function declaration.
-        spdlog::debug( "Declaring function: {} with {} parameters", ast->name, ast->params.size() );
+        context.logger->debug( "Declaring function: {} with {} parameters", ast->name, ast->params.size() );
         s.storage = ast->block ? StorageClass::Extern : StorageClass::None;
         s.current_scope = true;
-        spdlog::debug( "put symbol: {:s} current_scope: {}", to_string( s ), s.current_scope );
+        context.logger->debug( "put symbol: {:s} current_scope: {}", to_string( s ), s.current_scope );
         table.put( ast->name, s );
-        global_table->put( ast->name, s );
+        context.symbol_table.put( ast->name, s );
     }
 
     // Check for labels that were used but not defined.
@@ -260,7 +257,7 @@ out:
 }
 
 void SemanticAnalyser::visit_Statement( const ast::Statement ast, SymbolTable& table ) {
-    spdlog::debug( "Statement: {}" );
+    context.logger->debug( "Statement: {}" );
     if ( ast->label ) {
         visit_Label( ast->label.value() );
     }
@@ -271,7 +268,7 @@ void SemanticAnalyser::visit_Statement( const ast::Statement ast, SymbolTable& t
 }
 
 void SemanticAnalyser::statement( const ast::StatementItem ast, SymbolTable& table ) {
-    spdlog::debug( "statement: {}" );
+    context.logger->debug( "statement: {}" );
     std::visit( overloaded { [ this, &table ]( ast::Return ast ) -> void { visit_Return( ast, table ); },
                              [ this, &table ]( ast::If ast ) -> void { visit_If( ast, table ); },
                              [ this ]( ast::Goto ast ) -> void { visit_Goto( ast ); },
@@ -294,7 +291,7 @@ void SemanticAnalyser::statement( const ast::StatementItem ast, SymbolTable& tab
 }
 
 void SemanticAnalyser::block_variable_def( const ast::VariableDef ast, SymbolTable& table ) {
-    spdlog::debug( "block variable def: {}", ast->name );
+    context.logger->debug( "block variable def: {}", ast->name );
 
     if ( ast->storage == StorageClass::Extern ) {
         // extern variables can't have initializers
@@ -308,13 +305,13 @@ void SemanticAnalyser::block_variable_def( const ast::VariableDef ast, SymbolTab
                 throw SemanticException( ast->location, "Function {} redeclared as variable", ast->name );
             }
             // Previous declaration
-            spdlog::debug( "1" );
+            context.logger->debug( "1" );
             if ( old_dec->current_scope &&
                  ( old_dec->storage == StorageClass::None || old_dec->storage == StorageClass::Static ) ) {
                 throw SemanticException( ast->location, "Conflicting local definitions: {}", ast->name );
             }
 
-            spdlog::debug( "2" );
+            context.logger->debug( "2" );
             // Conflicts with parameter
             if ( old_dec->current_scope && old_dec->storage == StorageClass::Parameter ) {
                 throw SemanticException( ast->location, "Conflicting local parameter: {}", ast->name );
@@ -333,9 +330,9 @@ void SemanticAnalyser::block_variable_def( const ast::VariableDef ast, SymbolTab
         }
 
         // Add the variable to the symbol table
-        spdlog::debug( "Declaring extern variable: {}", ast->name );
+        context.logger->debug( "Declaring extern variable: {}", ast->name );
         Symbol s { .name = ast->name, .storage = StorageClass::Extern, .type = ast->var_type, .current_scope = true };
-        global_table->put( ast->name, s );
+        context.symbol_table.put( ast->name, s );
         table.put( ast->name, s );
         return;
     }
@@ -360,8 +357,8 @@ void SemanticAnalyser::block_variable_def( const ast::VariableDef ast, SymbolTab
             }
         }
 
-        auto unique_name = table.temp_name( ast->name );
-        spdlog::debug( "Declaring static variable: {} as {}", ast->name, unique_name );
+        auto unique_name = context.names.temp_name( ast->name );
+        context.logger->debug( "Declaring static variable: {} as {}", ast->name, unique_name );
         auto s = Symbol { .name = unique_name,
                           .storage = StorageClass::Static,
                           .type = ast->var_type,
@@ -369,7 +366,7 @@ void SemanticAnalyser::block_variable_def( const ast::VariableDef ast, SymbolTab
                           .current_scope = true };
         table.put( ast->name, s );
         s.current_scope = false;
-        global_table->put( unique_name, s );
+        context.symbol_table.put( unique_name, s );
         ast->name = unique_name;
         if ( ast->init ) {
             expr( ast->init.value(), table );
@@ -379,7 +376,7 @@ void SemanticAnalyser::block_variable_def( const ast::VariableDef ast, SymbolTab
 
     // No linkage
     if ( auto old_dec = table.find( ast->name ); old_dec ) {
-        spdlog::debug( "Variable {} already defined - {}", ast->name, to_string( *old_dec ) );
+        context.logger->debug( "Variable {} already defined - {}", ast->name, to_string( *old_dec ) );
         if ( !is_integer( old_dec->type ) && old_dec->current_scope ) {
             // Another symbol is already defined with the same name, but it is not a variable.
             throw SemanticException( ast->location, "Function {} redeclared as variable.", ast->name );
@@ -398,8 +395,8 @@ void SemanticAnalyser::block_variable_def( const ast::VariableDef ast, SymbolTab
         }
     }
 
-    auto unique_name = table.temp_name( ast->name );
-    spdlog::debug( "Declaring local variable: {} as {}", ast->name, unique_name );
+    auto unique_name = context.names.temp_name( ast->name );
+    context.logger->debug( "Declaring local variable: {} as {}", ast->name, unique_name );
     table.put(
         ast->name,
         Symbol { .name = unique_name, .storage = StorageClass::None, .type = ast->var_type, .current_scope = true } );
@@ -425,7 +422,7 @@ void SemanticAnalyser::visit_Goto( const ast::Goto ast ) {
 }
 
 void SemanticAnalyser::visit_Label( const ast::Label ast ) {
-    spdlog::debug( "Label: {}", ast->label );
+    context.logger->debug( "Label: {}", ast->label );
     if ( labels.contains( ast->label ) && labels[ ast->label ] == true ) {
         throw SemanticException( ast->location, "Duplicate label in function: {}", ast->label );
     }
@@ -524,7 +521,7 @@ void SemanticAnalyser::visit_Switch( const ast::Switch ast, SymbolTable& table )
 }
 
 void SemanticAnalyser::visit_Case( const ast::Case ast, SymbolTable& table ) {
-    spdlog::debug( "case: {}", ast->is_default ? "default" : "case" );
+    context.logger->debug( "case: {}", ast->is_default ? "default" : "case" );
 
     // Check if we are in a switch statement
     if ( case_set.empty() ) {
@@ -575,7 +572,7 @@ void SemanticAnalyser::visit_Case( const ast::Case ast, SymbolTable& table ) {
 }
 
 void SemanticAnalyser::visit_Compound( const ast::Compound ast, SymbolTable& table ) {
-    spdlog::debug( "Compound" );
+    context.logger->debug( "Compound" );
 
     for ( const auto& item : ast->block_items ) {
         std::visit( overloaded { [ this, &table ]( ast::VariableDef d ) -> void { block_variable_def( d, table ); },
@@ -708,7 +705,7 @@ void SemanticAnalyser::visit_Assign( const ast::Assign ast, SymbolTable& table )
 }
 
 void SemanticAnalyser::visit_Call( const ast::Call ast, SymbolTable& table ) {
-    spdlog::debug( "Call: {}", ast->function_name );
+    context.logger->debug( "Call: {}", ast->function_name );
     // Check if the function is declared
     auto symbol = table.find( ast->function_name );
     if ( !symbol || is_integer( symbol->type ) ) {
@@ -739,7 +736,7 @@ void SemanticAnalyser::visit_Var( const ast::Var ast, const SymbolTable& table )
             throw SemanticException( ast->location, "Variable {} cannot be of type function", ast->name );
         }
 
-        spdlog::debug( "Found var: {} for {}", name->name, ast->name );
+        context.logger->debug( "Found var: {} for {}", name->name, ast->name );
         ast->name = name->name; // Change the name to the temporary.
         ast->base_type = name->type;
 
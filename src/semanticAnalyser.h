@@ -17,6 +17,7 @@
 #include "ast/base.h"
 #include "ast/constantint.h"
 #include "ast/visitor.h"
+#include "compilationContext.h"
 #include "symbolTable.h"
 
 template <> struct std::less<ast::ConstantInt> {
@@ -27,10 +28,11 @@ template <> struct std::less<ast::ConstantInt> {
 
 class SemanticAnalyser {
   public:
-    explicit SemanticAnalyser() = default;
+    explicit SemanticAnalyser( CompilationContext& context ) : context( context ) {};
     ~SemanticAnalyser() = default;
 
-    void analyse( ast::Program ast, SymbolTable& table );
+    // Analyse the program, filling in the symbol table of the compilation.
+    void analyse( ast::Program ast );
 
   private:
     void program( ast::Program ast, SymbolTable& table );
@@ -98,5 +100,5 @@ class SemanticAnalyser {
     // Nested function
     bool nested_function { false };
 
-    SymbolTable* global_table { nullptr };
+    CompilationContext& context;
 };
@@ -29,10 +29,6 @@ AssemblyType to_assembly_type( Type const& t ) {
     }
 }
 
-std::string SymbolTable::temp_name( std::string_view basename ) {
-    return std::format( "{}.{}", basename, temp_counter++ );
-}
-
 std::optional<Symbol> SymbolTable::find( const std::string& name ) const {
     if ( table.contains( name ) ) {
         return table.at( name );
@@ -44,7 +40,7 @@ bool SymbolTable::contains( const std::string& name ) const {
     return table.contains( name );
 }
 
-void SymbolTable::copy( SymbolTable& other ) {
+void SymbolTable::copy( SymbolTable const& other ) {
     table.insert( other.table.begin(), other.table.end() );
 }
 
@@ -54,8 +50,8 @@ void SymbolTable::reset_current_block() {
     }
 }
 
-void SymbolTable::dump() {
-    for ( auto& [ name, symbol ] : table ) {
-        std::println( "{}: {} ", name, to_string( symbol ) );
+void SymbolTable::dump( std::FILE* out ) const {
+    for ( auto const& [ name, symbol ] : table ) {
+        std::println( out, "{}: {} ", name, to_string( symbol ) );
     }
 }
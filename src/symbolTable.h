@@ -10,12 +10,13 @@
 
 #pragma once
 
+#include <cstdio>
 #include <map>
 #include <string>
 
 #include "symbol.h"
 
-// Symbol table - at the moment a map from string to string, and also maker of temporary names.
+// Symbol table - at the moment a map from string to string.
 class SymbolTable {
   public:
     SymbolTable() = default;
@@ -24,18 +25,13 @@ class SymbolTable {
     void put( std::string const& name, const Symbol& value ) { table.insert_or_assign( name, value ); };
     [[nodiscard]] std::optional<Symbol> find( const std::string& name ) const;
     bool                                contains( const std::string& name ) const;
-    void                                copy( SymbolTable& other );
+    void                                copy( SymbolTable const& other );
     void                                reset_current_block();
-    void                                dump();
+    void                                dump( std::FILE* out = stdout ) const;
 
     [[nodiscard]] auto begin() const { return table.cbegin(); }
     [[nodiscard]] auto end() const { return table.cend(); }
 
-    std::string temp_name( std::string_view basename = "temp" );
-
   private:
     std::map<std::string, Symbol> table;
-    static std::int32_t           temp_counter;
-};
-
-inline std::int32_t SymbolTable::temp_counter = 0;
\ No newline at end of file
+};
\ No newline at end of file
@@ -10,8 +10,6 @@
 
 #include "tacGen.h"
 
-#include <spdlog/spdlog.h>
-
 #include "ast/includes.h"
 #include "common.h"
 #include "exception.h"
@@ -40,10 +38,9 @@ tac::Program TacGen::generate( ast::Program ast ) {
                     d );
     }
 
-    symbol_table.dump();
     for ( auto const& [ name, symbol ] : symbol_table ) {
         if ( symbol.type != Type::FUNCTION && symbol.storage != StorageClass::Extern ) {
-            spdlog::debug( "tac::generate: {} is defined as {}", name, symbol.number );
+            context.logger->debug( "tac::generate: {} is defined as {}", name, symbol.number );
             auto static_var = mk_node<tac::StaticVariable_>( ast, name, symbol.storage == StorageClass::None,
                                                              symbol.type, symbol.number );
             program->top_level.emplace_back( static_var );
@@ -54,10 +51,10 @@ tac::Program TacGen::generate( ast::Program ast ) {
 }
 
 std::optional<tac::FunctionDef> TacGen::functionDef( ast::FunctionDef ast ) {
-    spdlog::debug( "tac::functionDef: {}", ast->name );
+    context.logger->debug( "tac::functionDef: {}", ast->name );
     if ( !ast->block ) {
         // extern function, don't generate TAC
-        spdlog::debug( "tac::functionDef: {} is extern, skipping", ast->name );
+        context.logger->debug( "tac::functionDef: {} is extern, skipping", ast->name );
         return std::nullopt;
     }
     auto function = mk_node<tac::FunctionDef_>( ast );
@@ -84,7 +81,7 @@ std::optional<tac::StaticVariable> TacGen::staticVariable( ast::VariableDef ast
         int value { 0 };
         if ( auto s = symbol_table.find( ast->name ); s ) {
             value = s->number;
-            spdlog::debug( "tac::staticVariable: {} is defined, using {}", ast->name, value );
+            context.logger->debug( "tac::staticVariable: {} is defined, using {}", ast->name, value );
         }
         auto static_var =
             mk_node<tac::StaticVariable_>( ast, ast->name, ast->storage == StorageClass::None, ast->var_type, value );
@@ -94,7 +91,7 @@ std::optional<tac::StaticVariable> TacGen::staticVariable( ast::VariableDef ast
 }
 
 void TacGen::declaration( ast::VariableDef ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::declaration: {} {}", ast->name, ast->init ? "init" : "" );
+    context.logger->debug( "tac::declaration: {} {}", ast->name, ast->init ? "init" : "" );
     if ( ast->init && !symbol_table.contains( ast->name ) ) {
         // Can't initialise a static variable
         auto result = expr( *ast->init, instructions );
@@ -105,7 +102,7 @@ void TacGen::declaration( ast::VariableDef ast, std::vector<tac::Instruction>& i
 }
 
 void TacGen::statement( const ast::Statement ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::statement" );
+    context.logger->debug( "tac::statement" );
 
     if ( ast->label ) {
         label( ast->label.value(), instructions );
@@ -132,7 +129,7 @@ void TacGen::statement( const ast::Statement ast, std::vector<tac::Instruction>&
 }
 
 void TacGen::ret( ast::Return ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::ret: {}" );
+    context.logger->debug( "tac::ret: {}" );
 
     // Do expression
     auto value = expr( ast->expr, instructions );
@@ -143,7 +140,7 @@ void TacGen::ret( ast::Return ast, std::vector<tac::Instruction>& instructions )
 }
 
 void TacGen::if_stat( ast::If ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::if_stat" );
+    context.logger->debug( "tac::if_stat" );
     auto end_label = generate_label( ast, "ifend" );
     auto else_label = generate_label( ast, "else" );
 
@@ -173,31 +170,31 @@ void TacGen::if_stat( ast::If ast, std::vector<tac::Instruction>& instructions )
     instructions.emplace_back( end_label );
 }
 void TacGen::goto_stat( ast::Goto ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::goto_stat: {}", ast->label );
+    context.logger->debug( "tac::goto_stat: {}", ast->label );
     auto jump = mk_node<tac::Jump_>( ast, ast->label );
     instructions.emplace_back( jump );
 }
 
 void TacGen::label( ast::Label ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::label: {}", ast->label );
+    context.logger->debug( "tac::label: {}", ast->label );
     auto label = mk_node<tac::Label_>( ast, ast->label );
     instructions.emplace_back( label );
 }
 
 void TacGen::break_stat( const ast::Break ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::break_stat: {}", ast->ast_label );
+    context.logger->debug( "tac::break_stat: {}", ast->ast_label );
     auto jump = mk_node<tac::Jump_>( ast, "break_" + ast->ast_label );
     instructions.emplace_back( jump );
 }
 
 void TacGen::continue_stat( const ast::Continue ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::continue_stat: {}", ast->ast_label );
+    context.logger->debug( "tac::continue_stat: {}", ast->ast_label );
     auto jump = mk_node<tac::Jump_>( ast, "continue_" + ast->ast_label );
     instructions.emplace_back( jump );
 }
 
 void TacGen::while_stat( const ast::While ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::while_stat: {}", ast->ast_label );
+    context.logger->debug( "tac::while_stat: {}", ast->ast_label );
 
     // Label(continue_label)
     auto continue_label = generate_loop_continue( ast );
@@ -221,7 +218,7 @@ void TacGen::while_stat( const ast::While ast, std::vector<tac::Instruction>& in
 }
 
 void TacGen::do_while_stat( const ast::DoWhile ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::do_stat: {}", ast->ast_label );
+    context.logger->debug( "tac::do_stat: {}", ast->ast_label );
     // Label(start)
     auto start = generate_label( ast, "do_while_start" );
     instructions.emplace_back( start );
@@ -240,7 +237,7 @@ void TacGen::do_while_stat( const ast::DoWhile ast, std::vector<tac::Instruction
 }
 
 void TacGen::for_stat( const ast::For ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::for_stat: {}", ast->ast_label );
+    context.logger->debug( "tac::for_stat: {}", ast->ast_label );
     auto break_label = generate_loop_break( ast );
 
     // Instructions for init
@@ -283,13 +280,13 @@ void TacGen::for_stat( const ast::For ast, std::vector<tac::Instruction>& instru
 }
 
 void TacGen::switch_stat( const ast::Switch ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::switch_stat: {}", ast->ast_label );
+    context.logger->debug( "tac::switch_stat: {}", ast->ast_label );
 
     // Instruction for condition
     auto c = expr( ast->condition, instructions );
 
     for ( const auto& case_item : ast->cases ) {
-        spdlog::debug( "tac::switch_stat: case {}", case_item->ast_label );
+        context.logger->debug( "tac::switch_stat: case {}", case_item->ast_label );
         // Generate label for case
         auto case_label = generate_label( case_item, std::format( "{}.case", case_item->ast_label ) );
         // Relabel the case item
@@ -325,12 +322,12 @@ void TacGen::switch_stat( const ast::Switch ast, std::vector<tac::Instruction>&
 }
 
 void TacGen::case_stat( const ast::Case ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::case_stat: {}", ast->ast_label );
+    context.logger->debug( "tac::case_stat: {}", ast->ast_label );
     auto label = mk_node<tac::Label_>( ast, ast->ast_label );
     instructions.emplace_back( label );
 
     for ( auto b : ast->block_items ) {
-        spdlog::debug( "tac::case_stat: block" );
+        context.logger->debug( "tac::case_stat: block" );
         std::visit(
             overloaded { [ this, &instructions ]( ast::VariableDef ast ) -> void { declaration( ast, instructions ); },
                          []( ast::FunctionDef ) -> void {},
@@ -340,9 +337,9 @@ void TacGen::case_stat( const ast::Case ast, std::vector<tac::Instruction>& inst
 }
 
 void TacGen::compound( ast::Compound ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::compound:" );
+    context.logger->debug( "tac::compound:" );
     for ( auto b : ast->block_items ) {
-        spdlog::debug( "tac::functionDef: block" );
+        context.logger->debug( "tac::functionDef: block" );
         std::visit(
             overloaded { [ this, &instructions ]( ast::VariableDef ast ) -> void { declaration( ast, instructions ); },
                          []( ast::FunctionDef ) -> void {},
@@ -352,7 +349,7 @@ void TacGen::compound( ast::Compound ast, std::vector<tac::Instruction>& instruc
 }
 
 tac::Value TacGen::expr( ast::Expr ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::expr" );
+    context.logger->debug( "tac::expr" );
     return std::visit(
         overloaded {
             [ &instructions, this ]( ast::UnaryOp u ) -> tac::Value { return unary( u, instructions ); },
@@ -368,7 +365,7 @@ tac::Value TacGen::expr( ast::Expr ast, std::vector<tac::Instruction>& instructi
 }
 
 tac::Value TacGen::unary( ast::UnaryOp ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::unary: {}", to_string( ast->op ) );
+    context.logger->debug( "tac::unary: {}", to_string( ast->op ) );
 
     // Handle increment and decrement
     if ( ast->op == TokenType::INCREMENT || ast->op == TokenType::DECREMENT ) {
@@ -417,7 +414,7 @@ tac::Value TacGen::unary( ast::UnaryOp ast, std::vector<tac::Instruction>& instr
 }
 
 tac::Value TacGen::binary( ast::BinaryOp ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::binary: {}", to_string( ast->op ) );
+    context.logger->debug( "tac::binary: {}", to_string( ast->op ) );
     auto b = mk_node<tac::Binary_>( ast );
     switch ( ast->op ) {
     case TokenType::PLUS :
@@ -516,7 +513,7 @@ tac::Value TacGen::post( ast::PostOp ast, std::vector<tac::Instruction>& instruc
 }
 
 tac::Value TacGen::logical( ast::BinaryOp ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::logical: {}", to_string( ast->op ) );
+    context.logger->debug( "tac::logical: {}", to_string( ast->op ) );
     auto false_label = generate_label( ast, "logicalfalse" ); // For AND
     auto true_label = generate_label( ast, "logicaltrue" );   // For OR
     auto end_label = generate_label( ast, "logicalend" );
@@ -578,7 +575,7 @@ tac::Value TacGen::logical( ast::BinaryOp ast, std::vector<tac::Instruction>& in
 }
 
 tac::Value TacGen::conditional( ast::Conditional ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::conditional" );
+    context.logger->debug( "tac::conditional" );
     auto end_label = generate_label( ast, "ternend" );
     auto e2_label = generate_label( ast, "terne2" );
     auto result = temp_var( Type::INT );
@@ -677,7 +674,7 @@ tac::Value TacGen::call( const ast::Call ast, std::vector<tac::Instruction>& ins
     if ( auto f = symbol_table.find( ast->function_name ) ) {
         if ( f.value().storage == StorageClass::Extern ) {
             // Extern function, no need to generate code
-            spdlog::debug( "tac::call: {} is extern", ast->function_name );
+            context.logger->debug( "tac::call: {} is extern", ast->function_name );
             func->external = true;
         }
     } else {
@@ -689,7 +686,7 @@ tac::Value TacGen::call( const ast::Call ast, std::vector<tac::Instruction>& ins
 }
 
 tac::Value TacGen::cast( const ast::Cast ast, std::vector<tac::Instruction>& instructions ) {
-    spdlog::debug( "tac::cast: {}", to_string( ast->type ) );
+    context.logger->debug( "tac::cast: {}", to_string( ast->type ) );
     auto src = expr( ast->expr, instructions );
     if ( ast->base_type == ast->type ) {
         // Same type
@@ -710,7 +707,7 @@ tac::Value TacGen::cast( const ast::Cast ast, std::vector<tac::Instruction>& ins
 }
 
 tac::Label TacGen::generate_label( const std::shared_ptr<ast::Base> b, std::string_view name ) {
-    return mk_node<tac::Label_>( b, std::format( "{:s}.{:d}", name, label_count++ ) );
+    return mk_node<tac::Label_>( b, context.names.label( name ) );
 }
 
 tac::Value TacGen::constant( ast::Constant ast ) {
@@ -722,7 +719,7 @@ tac::Value TacGen::constant( ast::Constant ast ) {
 }
 
 tac::Value TacGen::temp_var( Type type ) {
-    return std::make_shared<tac::Variable_>( Location(), symbol_table.temp_name(), type );
+    return std::make_shared<tac::Variable_>( Location(), context.names.temp_name(), type );
 };
 
 tac::Label TacGen::generate_loop_break( std::shared_ptr<ast::Base> b ) {
@@ -12,13 +12,14 @@
 
 #include "ast/base.h"
 #include "ast/visitor.h"
+#include "compilationContext.h"
 #include "symbolTable.h"
 #include "tac/includes.h"
 #include "tac/visitor.h"
 
 class TacGen {
   public:
-    TacGen( SymbolTable& symbol_table ) : symbol_table( symbol_table ) {};
+    explicit TacGen( CompilationContext& context ) : context( context ), symbol_table( context.symbol_table ) {};
     ~TacGen() = default;
 
     tac::Program generate( ast::Program ast );
@@ -59,6 +60,6 @@ class TacGen {
     static tac::Label generate_loop_break( std::shared_ptr<ast::Base> b );
     static tac::Label generate_loop_continue( std::shared_ptr<ast::Base> b );
 
-    SymbolTable& symbol_table;
-    size_t       label_count {};
+    CompilationContext& context;
+    SymbolTable&        symbol_table;
 };
@@ -0,0 +1,149 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "tacHash.h"
+
+#include <cstdint>
+
+#include "exception.h"
+
+std::string TacHash::hash( tac::FunctionDef const function ) {
+    state = Hash {};
+    names.clear();
+    labels.clear();
+    function->accept( this );
+    return state.hex();
+}
+
+void TacHash::visit_Program( tac::Program const ast ) {
+    throw CodeException( ast->location, "TacHash hashes functions" );
+}
+
+void TacHash::visit_FunctionDef( tac::FunctionDef const ast ) {
+    function_line = ast->location.line;
+    state.add( ast->name ).add( ast->global );
+    state.add( ast->params.size() );
+    for ( auto const& param : ast->params ) {
+        name( param );
+    }
+    state.add( ast->instructions.size() );
+    for ( auto const& instr : ast->instructions ) {
+        std::visit( [ this ]( auto&& i ) -> void { i->accept( this ); }, instr );
+    }
+}
+
+void TacHash::visit_StaticVariable( tac::StaticVariable const ast ) {
+    throw CodeException( ast->location, "TacHash hashes functions" );
+}
+
+void TacHash::visit_Return( tac::Return const ast ) {
+    instruction( Kind::Return, *ast );
+    value( ast->value );
+}
+
+void TacHash::visit_Unary( tac::Unary const ast ) {
+    instruction( Kind::Unary, *ast );
+    state.add( ast->op );
+    value( ast->src );
+    value( ast->dst );
+}
+
+void TacHash::visit_Binary( tac::Binary const ast ) {
+    instruction( Kind::Binary, *ast );
+    state.add( ast->op );
+    value( ast->src1 );
+    value( ast->src2 );
+    value( ast->dst );
+}
+
+void TacHash::visit_Copy( tac::Copy const ast ) {
+    instruction( Kind::Copy, *ast );
+    value( ast->src );
+    value( ast->dst );
+}
+
+void TacHash::visit_Jump( tac::Jump const ast ) {
+    instruction( Kind::Jump, *ast );
+    label( ast->target );
+}
+
+void TacHash::visit_JumpIfZero( tac::JumpIfZero const ast ) {
+    instruction( Kind::JumpIfZero, *ast );
+    value( ast->condition );
+    label( ast->target );
+}
+
+void TacHash::visit_JumpIfNotZero( tac::JumpIfNotZero const ast ) {
+    instruction( Kind::JumpIfNotZero, *ast );
+    value( ast->condition );
+    label( ast->target );
+}
+
+void TacHash::visit_Label( tac::Label const ast ) {
+    instruction( Kind::Label, *ast );
+    label( ast->name );
+}
+
+void TacHash::visit_FunCall( tac::FunCall const ast ) {
+    instruction( Kind::FunCall, *ast );
+    state.add( ast->function_name ).add( ast->external );
+    state.add( ast->arguments.size() );
+    for ( auto const& arg : ast->arguments ) {
+        value( arg );
+    }
+    value( ast->dst );
+}
+
+void TacHash::visit_SignExtend( tac::SignExtend const ast ) {
+    instruction( Kind::SignExtend, *ast );
+    value( ast->src );
+    value( ast->dst );
+}
+
+void TacHash::visit_Truncate( tac::Truncate const ast ) {
+    instruction( Kind::Truncate, *ast );
+    value( ast->src );
+    value( ast->dst );
+}
+
+void TacHash::visit_ConstantInt( tac::ConstantInt const ast ) {
+    state.add( Kind::ConstantInt ).add( ast->value );
+}
+
+void TacHash::visit_ConstantLong( tac::ConstantLong const ast ) {
+    state.add( Kind::ConstantLong ).add( ast->value );
+}
+
+void TacHash::visit_Variable( tac::Variable const ast ) {
+    state.add( Kind::Variable ).add( ast->type );
+    name( ast->name );
+}
+
+void TacHash::instruction( Kind const kind, tac::Base const& ast ) {
+    state.add( kind ).add( static_cast<std::int64_t>( ast.location.line ) - static_cast<std::int64_t>( function_line ) );
+}
+
+void TacHash::value( tac::Value const& ast ) {
+    std::visit( [ this ]( auto&& v ) -> void { v->accept( this ); }, ast );
+}
+
+void TacHash::name( std::string const& name ) {
+    if ( symbol_table.contains( name ) ) {
+        state.add( Kind::Global ).add( name );
+        return;
+    }
+    auto const [ found, _ ] = names.try_emplace( name, names.size() );
+    state.add( Kind::Local ).add( found->second );
+}
+
+void TacHash::label( std::string const& name ) {
+    auto const [ found, _ ] = labels.try_emplace( name, labels.size() );
+    state.add( found->second );
+}
@@ -0,0 +1,66 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "hash.h"
+#include "symbolTable.h"
+#include "tac/includes.h"
+#include "tac/visitor.h"
+
+// A hash of the structure of a TAC function, for the function cache of the code generators. Functions which differ
+// only in the names of their temporaries, local variables and labels hash the same, as do functions which are moved
+// in the file: the lines of the instructions are hashed from the line of the function. Names in the symbol table, the
+// static and global variables, are hashed as they are, as are the names of functions.
+class TacHash : public tac::Visitor<void> {
+  public:
+    explicit TacHash( SymbolTable const& symbol_table ) : symbol_table( symbol_table ) {};
+    ~TacHash() override = default;
+
+    // 32 hex digits
+    std::string hash( tac::FunctionDef function );
+
+    void visit_Program( tac::Program ast ) override;
+    void visit_FunctionDef( tac::FunctionDef ast ) override;
+    void visit_StaticVariable( tac::StaticVariable ast ) override;
+    void visit_Return( tac::Return ast ) override;
+    void visit_Unary( tac::Unary ast ) override;
+    void visit_Binary( tac::Binary ast ) override;
+    void visit_Copy( tac::Copy ast ) override;
+    void visit_Jump( tac::Jump ast ) override;
+    void visit_JumpIfZero( tac::JumpIfZero ast ) override;
+    void visit_JumpIfNotZero( tac::JumpIfNotZero ast ) override;
+    void visit_Label( tac::Label ast ) override;
+    void visit_FunCall( tac::FunCall ast ) override;
+    void visit_SignExtend( tac::SignExtend ast ) override;
+    void visit_Truncate( tac::Truncate ast ) override;
+
+    void visit_ConstantInt( tac::ConstantInt ast ) override;
+    void visit_ConstantLong( tac::ConstantLong ast ) override;
+    void visit_Variable( tac::Variable ast ) override;
+
+  private:
+    enum class Kind : std::uint8_t { Return, Unary, Binary, Copy, Jump, JumpIfZero, JumpIfNotZero, Label, FunCall,
+                                     SignExtend, Truncate, ConstantInt, ConstantLong, Variable, Global, Local };
+
+    void instruction( Kind kind, tac::Base const& ast );
+    void value( tac::Value const& ast );
+    void name( std::string const& name );
+    void label( std::string const& name );
+
+    SymbolTable const&            symbol_table;
+    Hash                          state;
+    std::map<std::string, size_t> names;  // local names, numbered in order of use
+    std::map<std::string, size_t> labels; // the same for labels
+    size_t                        function_line { 0 };
+};
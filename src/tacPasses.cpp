@@ -0,0 +1,73 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 16/10/2026.
+//
+
+#include "tacPasses.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+#include "constantFold.h"
+#include "deadCode.h"
+
+using PassFactory = std::function<std::unique_ptr<TacPass>()>;
+
+std::map<std::string, PassFactory> const& tac_pass_registry() {
+    static const std::map<std::string, PassFactory> registry = {
+        { "constfold", []() { return std::make_unique<ConstantFold>(); } },
+        { "dce", []() { return std::make_unique<DeadCode>(); } },
+    };
+    return registry;
+}
+
+std::vector<std::string> const& tac_pass_names() {
+    static const std::vector<std::string> names = [] {
+        std::vector<std::string> result;
+        for ( auto const& name : tac_pass_registry() | std::views::keys ) {
+            result.push_back( name );
+        }
+        return result;
+    }();
+    return names;
+}
+
+std::vector<std::string> tac_pipeline( Option const& option ) {
+    if ( !option.passes.empty() ) {
+        return option.passes;
+    }
+    switch ( option.opt_level ) {
+    case 0 :
+        return {};
+    case 1 :
+        return { "constfold" };
+    default :
+        return { "constfold", "dce" };
+    }
+}
+
+TacPassManager make_tac_passes( CompilationContext& context ) {
+    TacPassManager manager;
+    manager.set_instrumentation( context.option.instrument );
+    manager.set_logger( context.logger.get() );
+    for ( auto const& name : tac_pipeline( context.option ) ) {
+        auto const& registry = tac_pass_registry();
+        auto const  factory = registry.find( name );
+        if ( factory == registry.end() ) {
+            throw std::runtime_error( std::format( "Unknown pass: {}", name ) );
+        }
+        context.logger->debug( "TAC pass: {}", name );
+        manager.add( factory->second() );
+    }
+    return manager;
+}
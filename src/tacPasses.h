@@ -0,0 +1,31 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 16/10/2026.
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "compilationContext.h"
+#include "option.h"
+#include "passManager.h"
+#include "tac/includes.h"
+
+using TacPass = Pass<tac::Program>;
+using TacFunctionPass = FunctionPass<tac::Program, tac::FunctionDef>;
+using TacPassManager = PassManager<tac::Program>;
+
+// Names of the optional TAC passes, as used by --passes.
+std::vector<std::string> const& tac_pass_names();
+
+// The passes to run: the --passes list if given, otherwise the preset for the -O level.
+std::vector<std::string> tac_pipeline( Option const& option );
+
+TacPassManager make_tac_passes( CompilationContext& context );
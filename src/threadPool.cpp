@@ -0,0 +1,164 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "threadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <utility>
+
+#include "instrument.h"
+#include "jobServer.h"
+
+// The pool and queue of the worker running on this thread, if any.
+static thread_local ThreadPool const* current_pool { nullptr };
+static thread_local size_t            current_queue { 0 };
+
+ThreadPool::ThreadPool( size_t threads, JobServer* jobs, std::string_view const role ) : jobs( jobs ) {
+    if ( threads == 0 ) {
+        threads = std::max( 1u, std::thread::hardware_concurrency() );
+    }
+    for ( size_t i = 0; i < threads; ++i ) {
+        queues.push_back( std::make_unique<Queue>() );
+    }
+    for ( size_t i = 0; i < threads; ++i ) {
+        this->threads.emplace_back( [ this, i, name = std::format( "{} {}", role, i + 1 ) ]() mutable {
+            set_thread_role( std::move( name ) );
+            worker( i );
+        } );
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock( mutex );
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for ( auto& thread : threads ) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit( Task task ) {
+    {
+        std::lock_guard lock( mutex );
+        auto const      index = current_pool == this ? current_queue : next++ % queues.size();
+        {
+            std::lock_guard queue_lock( queues[ index ]->mutex );
+            queues[ index ]->tasks.push_back( std::move( task ) );
+        }
+        ++queued;
+        ++pending;
+    }
+    // With a jobserver, the one worker woken may be waiting for a token while the first worker, which needs none,
+    // sleeps, so all are woken.
+    if ( jobs ) {
+        work_ready.notify_all();
+    } else {
+        work_ready.notify_one();
+    }
+}
+
+void ThreadPool::wait() {
+    std::unique_lock lock( mutex );
+    all_done.wait( lock, [ this ] { return pending == 0; } );
+    if ( error ) {
+        std::rethrow_exception( std::exchange( error, nullptr ) );
+    }
+}
+
+void ThreadPool::worker( const size_t index ) {
+    current_pool = this;
+    current_queue = index;
+    bool const needs_token = jobs && index > 0;
+    bool       has_token = false;
+    while ( true ) {
+        if ( needs_token && !has_token ) {
+            if ( !take_token() ) {
+                return;
+            }
+            has_token = true;
+        }
+        Task task;
+        if ( pop( index, task ) || steal( index, task ) ) {
+            {
+                std::lock_guard lock( mutex );
+                --queued;
+            }
+            std::exception_ptr exception;
+            try {
+                task();
+            } catch ( ... ) {
+                exception = std::current_exception();
+            }
+            std::lock_guard lock( mutex );
+            if ( exception && !error ) {
+                error = exception;
+            }
+            if ( --pending == 0 ) {
+                all_done.notify_all();
+            }
+            continue;
+        }
+        if ( has_token ) {
+            jobs->release();
+            has_token = false;
+            continue;
+        }
+        std::unique_lock lock( mutex );
+        work_ready.wait( lock, [ this ] { return stopping || queued > 0; } );
+        if ( stopping && queued == 0 ) {
+            return;
+        }
+    }
+}
+
+// Wait for tasks to run and a token to run them with. Returns false if the pool is stopping.
+bool ThreadPool::take_token() {
+    constexpr auto retry = std::chrono::milliseconds( 100 ); // to see the pool stopping, or the tasks run by others
+    while ( true ) {
+        {
+            std::unique_lock lock( mutex );
+            work_ready.wait( lock, [ this ] { return stopping || queued > 0; } );
+            if ( stopping && queued == 0 ) {
+                return false;
+            }
+        }
+        if ( jobs->acquire( retry ) ) {
+            return true;
+        }
+    }
+}
+
+bool ThreadPool::pop( const size_t index, Task& task ) {
+    auto& queue = *queues[ index ];
+    std::lock_guard lock( queue.mutex );
+    if ( queue.tasks.empty() ) {
+        return false;
+    }
+    task = std::move( queue.tasks.back() );
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal( const size_t index, Task& task ) {
+    for ( size_t i = 1; i < queues.size(); ++i ) {
+        auto& queue = *queues[ ( index + i ) % queues.size() ];
+        std::lock_guard lock( queue.mutex );
+        if ( !queue.tasks.empty() ) {
+            task = std::move( queue.tasks.front() );
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
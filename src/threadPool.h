@@ -0,0 +1,73 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+class JobServer;
+
+// A fixed pool of worker threads. Each worker has its own queue of tasks, taking from the back, and steals from the
+// front of the other queues when its own is empty. Tasks submitted from a worker go on that worker's queue.
+//
+// With a make jobserver, the first worker runs in the process's own job slot, and the others take a token before
+// running tasks, giving it back when there are none left, so the pool only uses slots the build has spare.
+class ThreadPool {
+  public:
+    using Task = std::function<void()>;
+
+    // 0 threads is one per hardware thread. The workers have the thread role, see set_thread_role, of the role and
+    // their number.
+    explicit ThreadPool( size_t threads, JobServer* jobs = nullptr, std::string_view role = "worker" );
+    ~ThreadPool();
+
+    ThreadPool( ThreadPool const& ) = delete;
+    ThreadPool& operator=( ThreadPool const& ) = delete;
+
+    void submit( Task task );
+
+    // Wait until all the submitted tasks have run. Rethrows the first exception thrown by a task.
+    void wait();
+
+    [[nodiscard]] size_t size() const { return threads.size(); }
+
+  private:
+    struct Queue {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    void worker( size_t index );
+    bool take_token();
+    bool pop( size_t index, Task& task );
+    bool steal( size_t index, Task& task );
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread>            threads;
+    size_t                              next { 0 }; // queue for the next task submitted from outside the pool
+    JobServer*                          jobs;
+
+    std::mutex              mutex; // guards the counts below
+    std::condition_variable work_ready;
+    std::condition_variable all_done;
+    size_t                  queued { 0 };  // tasks in the queues
+    size_t                  pending { 0 }; // tasks submitted but not finished
+    bool                    stopping { false };
+    std::exception_ptr      error;
+};
@@ -0,0 +1,121 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "timeReport.h"
+
+#include <print>
+
+namespace {
+
+double to_ms( const std::chrono::nanoseconds t ) {
+    return std::chrono::duration<double, std::milli>( t ).count();
+}
+
+} // namespace
+
+void TimeReport::begin( const std::string_view region, const std::string_view function ) {
+    if ( function.empty() ) {
+        // Add the entry now, so that passes are listed before the passes nested inside them.
+        std::lock_guard lock( mutex );
+        auto&           depth = depths[ std::this_thread::get_id() ];
+        passes.find( region, function, depth );
+        ++depth;
+    }
+}
+
+void TimeReport::end( const std::string_view region, const std::string_view function, Timing const& timing ) {
+    std::lock_guard lock( mutex );
+    auto&           depth = depths[ std::this_thread::get_id() ];
+    if ( function.empty() ) {
+        --depth;
+    }
+    auto& entry = ( function.empty() ? passes : functions ).find( region, function, depth );
+    entry.count++;
+    entry.total.wall += timing.wall;
+    entry.total.cpu += timing.cpu;
+}
+
+TimeReport::Entry& TimeReport::Entries::find( const std::string_view region, const std::string_view function,
+                                              const int depth ) {
+    if ( auto const found = index.find( std::tuple( region, function, depth ) ); found != index.end() ) {
+        return list[ found->second ];
+    }
+    index.emplace( Key( region, function, depth ), list.size() );
+    return list.emplace_back(
+        Entry { .name = std::string( region ), .function = std::string( function ), .depth = depth } );
+}
+
+Timing TimeReport::total() const {
+    Timing result;
+    for ( auto const& entry : passes.list ) {
+        if ( entry.depth == 0 ) {
+            result.wall += entry.total.wall;
+            result.cpu += entry.total.cpu;
+        }
+    }
+    return result;
+}
+
+void TimeReport::report() {
+    switch ( format ) {
+    case Format::Table :
+        print_table();
+        break;
+    case Format::Json :
+        print_json();
+        break;
+    }
+    std::fflush( out );
+}
+
+void TimeReport::print_table() const {
+    auto const all = total();
+    std::println( out, "===--- Pass execution timing report ---===" );
+    std::println( out, "  Total: {:.3f} ms wall, {:.3f} ms CPU", to_ms( all.wall ), to_ms( all.cpu ) );
+    std::println( out, "" );
+    std::println( out, "{:>12} {:>12} {:>8} {:>6}  {}", "Wall (ms)", "CPU (ms)", "Wall %", "Count", "Pass" );
+    for ( auto const& entry : passes.list ) {
+        auto const percent = all.wall.count() > 0 ? 100.0 * entry.total.wall / all.wall : 0.0;
+        std::println( out, "{:12.3f} {:12.3f} {:7.1f}% {:6}  {}{}", to_ms( entry.total.wall ), to_ms( entry.total.cpu ),
+                      percent, entry.count, std::string( 2 * entry.depth, ' ' ), entry.name );
+    }
+    if ( functions.list.empty() ) {
+        return;
+    }
+    std::println( out, "" );
+    std::println( out, "{:>12} {:>12}  {:<16} {}", "Wall (ms)", "CPU (ms)", "Pass", "Function" );
+    for ( auto const& entry : functions.list ) {
+        std::println( out, "{:12.3f} {:12.3f}  {:<16} {}", to_ms( entry.total.wall ), to_ms( entry.total.cpu ),
+                      entry.name, entry.function );
+    }
+}
+
+void TimeReport::print_json() const {
+    auto const all = total();
+    std::println( out, "{{" );
+    std::println( out, R"(  "total": {{ "wall_ms": {:.6f}, "cpu_ms": {:.6f} }},)", to_ms( all.wall ), to_ms( all.cpu ) );
+    std::println( out, R"(  "passes": [)" );
+    for ( size_t i = 0; i < passes.list.size(); ++i ) {
+        auto const& entry = passes.list[ i ];
+        std::println( out, R"(    {{ "name": "{}", "depth": {}, "count": {}, "wall_ms": {:.6f}, "cpu_ms": {:.6f} }}{})",
+                      entry.name, entry.depth, entry.count, to_ms( entry.total.wall ), to_ms( entry.total.cpu ),
+                      i + 1 < passes.list.size() ? "," : "" );
+    }
+    std::println( out, "  ]," );
+    std::println( out, R"(  "functions": [)" );
+    for ( size_t i = 0; i < functions.list.size(); ++i ) {
+        auto const& entry = functions.list[ i ];
+        std::println( out, R"(    {{ "pass": "{}", "function": "{}", "wall_ms": {:.6f}, "cpu_ms": {:.6f} }}{})",
+                      entry.name, entry.function, to_ms( entry.total.wall ), to_ms( entry.total.cpu ),
+                      i + 1 < functions.list.size() ? "," : "" );
+    }
+    std::println( out, "  ]" );
+    std::println( out, "}}" );
+}
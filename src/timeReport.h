@@ -0,0 +1,68 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "instrument.h"
+
+// --time-passes: the wall clock and CPU time of each stage and pass, and of each function in the passes. When files
+// are compiled on several threads the times of all of them are added together.
+class TimeReport : public InstrumentListener {
+  public:
+    enum class Format { Table, Json };
+
+    TimeReport( Format format, std::FILE* out ) : format( format ), out( out ) {};
+    ~TimeReport() override = default;
+
+    void begin( std::string_view region, std::string_view function ) override;
+    void end( std::string_view region, std::string_view function, Timing const& timing ) override;
+    void report() override;
+
+  private:
+    struct Entry {
+        std::string name;
+        std::string function;
+        int         depth { 0 };
+        int         count { 0 };
+        Timing      total;
+    };
+
+    // The entries in the order first run, found by region, function and depth.
+    struct Entries {
+        using Key = std::tuple<std::string, std::string, int>;
+
+        std::vector<Entry>                 list;
+        std::map<Key, size_t, std::less<>> index;
+
+        Entry& find( std::string_view region, std::string_view function, int depth );
+    };
+
+    [[nodiscard]] Timing total() const;
+
+    void print_table() const;
+    void print_json() const;
+
+    Format                         format;
+    std::FILE*                     out;
+    std::mutex                     mutex;     // regions can end on several threads at once
+    std::map<std::thread::id, int> depths;    // nesting of the regions on each thread
+    Entries                        passes;
+    Entries                        functions; // per function in a pass
+};
@@ -55,6 +55,10 @@ const char* to_string( const TokenType l ) {
         return ":";
     case COMMA :
         return ",";
+    case HASH :
+        return "#";
+    case HASH_HASH :
+        return "##";
 
     case INCREMENT :
         return "++";
@@ -103,6 +107,8 @@ const char* to_string( const TokenType l ) {
         return "<constant>";
     case LONGLITERAL :
         return "<longliteral>";
+    case HEADER_NAME :
+        return "<header>";
 
     case Eof :
         return "<eof>";
@@ -159,4 +165,20 @@ std::string to_string( Token const& t ) {
     default :
         return to_string( t.tok );
     }
-}
\ No newline at end of file
+}
+
+std::string spelling( Token const& t ) {
+    switch ( t.tok ) {
+        using enum TokenType;
+    case IDENTIFIER :
+    case CONSTANT :
+    case HEADER_NAME :
+        return t.value;
+    case LONGLITERAL :
+        return t.value + "l";
+    case Eof :
+        return "";
+    default :
+        return to_string( t.tok );
+    }
+}
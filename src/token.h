@@ -10,7 +10,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <format>
+#include <string>
 
 enum class TokenType : std::uint8_t {
     Null = 0,
@@ -38,6 +40,8 @@ enum class TokenType : std::uint8_t {
     QUESTION,
     COLON,
     COMMA,
+    HASH,
+    HASH_HASH,
 
     INCREMENT,
     DECREMENT,
@@ -63,6 +67,7 @@ enum class TokenType : std::uint8_t {
     IDENTIFIER,
     CONSTANT,
     LONGLITERAL,
+    HEADER_NAME, // "file" or <file> after #include
 
     // Keywords
     BREAK,
@@ -123,14 +128,20 @@ class Token {
     constexpr Token( const TokenType t, const Location l ) : tok( t ), location( l ) {};
     constexpr Token( const TokenType t, const Location l, std::string v )
         : tok( t ), location( l ), value { std::move( v ) } {};
+    constexpr Token( const TokenType t, const Location l, std::string v, const std::uint64_t n )
+        : tok( t ), location( l ), value { std::move( v ) }, number( n ) {};
 
-    TokenType   tok;
-    Location    location;
-    std::string value;
+    TokenType     tok;
+    Location      location;
+    std::string   value;
+    std::uint64_t number { 0 }; // of a CONSTANT or LONGLITERAL, converted by the lexer
 };
 
 std::string to_string( Token const& t );
 
+// The text of the token as it appears in the source.
+std::string spelling( Token const& t );
+
 template <> struct std::formatter<Token> {
     constexpr static auto parse( const std::format_parse_context& ctx ) { return ctx.begin(); }
 
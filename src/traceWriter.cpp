@@ -0,0 +1,111 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include "traceWriter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <print>
+
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+
+namespace {
+
+// The text of a JSON string.
+std::string escape( std::string_view const text ) {
+    std::string result;
+    result.reserve( text.size() );
+    for ( auto const c : text ) {
+        switch ( c ) {
+        case '"' :
+            result += "\\\"";
+            break;
+        case '\\' :
+            result += "\\\\";
+            break;
+        case '\n' :
+            result += "\\n";
+            break;
+        case '\t' :
+            result += "\\t";
+            break;
+        default :
+            if ( static_cast<unsigned char>( c ) < 0x20 ) {
+                result += std::format( "\\u{:04x}", static_cast<unsigned>( c ) );
+            } else {
+                result += c;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TraceWriter::TraceWriter( std::string file_name )
+    : file_name( std::move( file_name ) ), start( std::chrono::steady_clock::now() ),
+      main_thread( std::this_thread::get_id() ) {}
+
+void TraceWriter::begin( const std::string_view region, const std::string_view function ) {
+    add( 'B', region, function );
+}
+
+void TraceWriter::end( const std::string_view region, const std::string_view function, Timing const& /*timing*/ ) {
+    add( 'E', region, function );
+}
+
+void TraceWriter::add( const char phase, const std::string_view region, const std::string_view function ) {
+    auto const now = std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count();
+    std::lock_guard lock( mutex );
+    // A function span is named after the function, inside the span of its pass.
+    events.push_back( Event { .phase = phase,
+                              .name = std::string( function.empty() ? region : function ),
+                              .category = function.empty() ? "pass" : std::string( region ),
+                              .timestamp = now,
+                              .thread = thread_id() } );
+}
+
+int TraceWriter::thread_id() {
+    auto const id = std::this_thread::get_id();
+    auto const thread = std::ranges::find( threads, id, &Thread::id );
+    if ( thread != threads.end() ) {
+        return static_cast<int>( thread - threads.begin() ) + 1;
+    }
+    auto name = thread_role();
+    if ( name.empty() ) {
+        name = id == main_thread ? "main" : std::format( "thread {}", threads.size() + 1 );
+    }
+    threads.push_back( { id, std::move( name ) } );
+    return static_cast<int>( threads.size() );
+}
+
+void TraceWriter::report() {
+    std::lock_guard lock( mutex );
+    auto* out = std::fopen( file_name.c_str(), "w" );
+    if ( out == nullptr ) {
+        spdlog::error( "Cannot open trace file {}.", file_name );
+        return;
+    }
+    auto const pid = getpid();
+    std::println( out, R"({{"displayTimeUnit": "ms", "traceEvents": [)" );
+    for ( size_t i = 0; i < threads.size(); ++i ) {
+        std::println( out, R"(  {{"ph": "M", "name": "thread_name", "pid": {}, "tid": {}, "args": {{"name": "{}"}}}},)",
+                      pid, i + 1, escape( threads[ i ].name ) );
+    }
+    for ( size_t i = 0; i < events.size(); ++i ) {
+        auto const& event = events[ i ];
+        std::println( out, R"(  {{"ph": "{}", "name": "{}", "cat": "{}", "ts": {:.3f}, "pid": {}, "tid": {}}}{})",
+                      event.phase, escape( event.name ), escape( event.category ), event.timestamp, pid, event.thread,
+                      i + 1 < events.size() ? "," : "" );
+    }
+    std::println( out, "]}}" );
+    std::fclose( out );
+}
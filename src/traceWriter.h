@@ -0,0 +1,54 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "instrument.h"
+
+// --trace-out: write the regions as Chrome trace events, viewable in chrome://tracing or Perfetto.
+class TraceWriter : public InstrumentListener {
+  public:
+    explicit TraceWriter( std::string file_name );
+    ~TraceWriter() override = default;
+
+    void begin( std::string_view region, std::string_view function ) override;
+    void end( std::string_view region, std::string_view function, Timing const& timing ) override;
+    void report() override;
+
+  private:
+    struct Event {
+        char        phase; // B or E
+        std::string name;
+        std::string category;
+        double      timestamp; // microseconds from the start
+        int         thread;
+    };
+
+    struct Thread {
+        std::thread::id id;
+        std::string     name;
+    };
+
+    void add( char phase, std::string_view region, std::string_view function );
+    int  thread_id();
+
+    std::string                           file_name;
+    std::chrono::steady_clock::time_point start;
+    std::thread::id                       main_thread; // which made the writer
+    std::mutex                            mutex;       // compilation can run on several threads
+    std::vector<Event>                    events;
+    std::vector<Thread>                   threads; // index is the thread id in the trace
+};
@@ -0,0 +1,70 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "compilationContext.h"
+#include "lexer.h"
+#include "parser.h"
+#include "printerTAC.h"
+#include "semanticAnalyser.h"
+#include "tacGen.h"
+#include "threadPool.h"
+
+std::string compile_tac( std::string const& input ) {
+    CompilationContext context( Option { .silent = true } );
+    std::istringstream is( input );
+    Lexer              lexer( is );
+    Parser             parser( lexer, context );
+    auto               ast = parser.parse();
+    SemanticAnalyser   analyser( context );
+    analyser.analyse( ast );
+    TacGen     tac_generator( context );
+    PrinterTAC printer;
+    return printer.print( tac_generator.generate( ast ) );
+}
+
+TEST( CompilationContext, Names ) { // NOLINT
+    NameGenerator first;
+    NameGenerator second;
+    EXPECT_EQ( first.temp_name(), "temp.0" );
+    EXPECT_EQ( first.temp_name( "x" ), "x.1" );
+    EXPECT_EQ( second.temp_name(), "temp.0" );
+    EXPECT_EQ( first.label( "else" ), "else.0" );
+    EXPECT_EQ( first.label( "ifend" ), "ifend.1" );
+}
+
+TEST( CompilationContext, Concurrent ) { // NOLINT
+    // The same program compiled at the same time on several threads gives the same names.
+    std::string const input = R"(
+        int f(int a, int b) {
+            int x = a;
+            for (int i = 0; i < b; i = i + 1) {
+                if (x > i) x = x - i; else x = x + b;
+            }
+            return x ? x : b;
+        }
+        int main(void) { return f(1, 2); })";
+    auto const expected = compile_tac( input );
+
+    std::vector<std::string> results( 64 );
+    ThreadPool               pool( 4 );
+    for ( auto& result : results ) {
+        pool.submit( [ &input, &result ] { result = compile_tac( input ); } );
+    }
+    pool.wait();
+    for ( auto const& result : results ) {
+        EXPECT_EQ( result, expected );
+    }
+}
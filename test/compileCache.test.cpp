@@ -0,0 +1,106 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "compileCache.h"
+#include "compiler.h"
+
+TEST( CompileCache, Compile ) { // NOLINT
+    auto const directory = std::filesystem::temp_directory_path() / std::format( "axc-cache-test-{}", getpid() );
+    std::filesystem::remove_all( directory );
+    CompileCache cache( directory );
+    Option       option { .silent = true, .input_file = "cached.c", .system = System::Linux };
+    auto const   uncached = compile_source( "int main(void) { return 2 + 3; }", option );
+
+    option.compile_cache = &cache;
+    auto const first = compile_source( "int main(void) { return 2 + 3; }", option );
+    EXPECT_EQ( cache.misses(), 2 ); // the file and its function
+    auto const second = compile_source( "int main(void) { return 2 + 3; }", option );
+    EXPECT_EQ( cache.hits(), 1 );
+    EXPECT_EQ( first.assembly, uncached.assembly );
+    EXPECT_EQ( second.assembly, uncached.assembly );
+
+    // Other options, and errors, are not found.
+    option.opt_level = 2;
+    compile_source( "int main(void) { return 2 + 3; }", option );
+    EXPECT_FALSE( compile_source( "int main(void) { return 2 +; }", option ).success );
+    EXPECT_FALSE( compile_source( "int main(void) { return 2 +; }", option ).success );
+    EXPECT_EQ( cache.hits(), 1 );
+
+    // Dumps are written even when the assembly is in the cache.
+    option.opt_level = 0;
+    option.dump_tac = true;
+    option.dump_file = std::tmpfile();
+    auto const dumped = compile_source( "int main(void) { return 2 + 3; }", option );
+    EXPECT_EQ( dumped.assembly, uncached.assembly );
+    EXPECT_EQ( cache.hits(), 1 );
+    EXPECT_GT( std::ftell( option.dump_file ), 0 );
+    std::fclose( option.dump_file );
+
+    std::filesystem::remove_all( directory );
+}
+
+TEST( CompileCache, Functions ) { // NOLINT
+    auto const directory = std::filesystem::temp_directory_path() / std::format( "axc-function-test-{}", getpid() );
+    std::filesystem::remove_all( directory );
+    CompileCache cache( directory );
+    Option       option { .silent = true, .input_file = "functions.c", .system = System::Linux };
+    auto const   source = "int other(void) { return 1; }\n\nint f(int b) { return b * 2; }\n"
+                          "int main(void) { return f(4); }";
+    auto const   uncached = compile_source( source, option );
+
+    option.compile_cache = &cache;
+    compile_source( "int f(int a) { return a * 2; }\nint main(void) { return f(3); }", option );
+    EXPECT_EQ( cache.hits(), 0 );
+
+    // f is found, though its names and lines are not the same, and has the line comments of where it is now.
+    auto const result = compile_source( source, option );
+    EXPECT_EQ( cache.hits(), 1 );
+    EXPECT_EQ( result.assembly, uncached.assembly );
+
+    std::filesystem::remove_all( directory );
+}
+
+TEST( CompileCache, Evict ) { // NOLINT
+    auto const directory = std::filesystem::temp_directory_path() / std::format( "axc-evict-test-{}", getpid() );
+    std::filesystem::remove_all( directory );
+    CompileCache cache( directory, 1000 );
+    cache.put( "00old", std::string( 400, 'a' ) );
+    cache.put( "01used", std::string( 400, 'b' ) );
+    // Make the times distinct, and old used last.
+    auto const now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time( directory / "00" / "old.s", now - std::chrono::seconds( 20 ) );
+    std::filesystem::last_write_time( directory / "01" / "used.s", now - std::chrono::seconds( 30 ) );
+    EXPECT_TRUE( cache.get( "01used" ) );
+
+    cache.put( "02new", std::string( 400, 'c' ) );
+    EXPECT_FALSE( cache.get( "00old" ) );
+    EXPECT_EQ( cache.get( "01used" ), std::string( 400, 'b' ) );
+    EXPECT_EQ( cache.get( "02new" ), std::string( 400, 'c' ) );
+
+    // A new cache finds the entries, and their size in the summary.
+    std::ifstream  summary { directory / "size" };
+    std::uintmax_t size = 0;
+    summary >> size;
+    EXPECT_EQ( size, 800 );
+    CompileCache again( directory, 1000 );
+    EXPECT_TRUE( again.get( "02new" ) );
+
+    std::filesystem::remove_all( directory );
+}
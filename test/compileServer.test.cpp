@@ -0,0 +1,100 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "compileServer.h"
+
+TEST( CompileServer, Protocol ) { // NOLINT
+    CompileRequest const request { .file = "a.c",
+                                   .machine = Machine::AArch64,
+                                   .system = System::Linux,
+                                   .opt_level = 2,
+                                   .passes = { "constfold", "dce" },
+                                   .defines = { "N=1" },
+                                   .source = "int main(void) {\n\n return 0; }\n" };
+    auto decoded = decode_request( encode_request( request ) );
+    ASSERT_TRUE( decoded );
+    EXPECT_EQ( decoded->file, request.file );
+    EXPECT_EQ( decoded->machine, request.machine );
+    EXPECT_EQ( decoded->system, request.system );
+    EXPECT_EQ( decoded->opt_level, request.opt_level );
+    EXPECT_EQ( decoded->passes, request.passes );
+    EXPECT_EQ( decoded->defines, request.defines );
+    EXPECT_EQ( decoded->source, request.source );
+
+    CompileResult const result { .success = false, .assembly = "", .diagnostics = { "one", "two\nlines" } };
+    auto                result_decoded = decode_result( encode_result( result ) );
+    ASSERT_TRUE( result_decoded );
+    EXPECT_FALSE( result_decoded->success );
+    EXPECT_EQ( result_decoded->diagnostics, ( std::vector<std::string> { "one", "two lines" } ) );
+
+    EXPECT_FALSE( decode_request( "file: a.c\nlength: 10\n\nshort" ) );
+    EXPECT_FALSE( decode_result( "status: ok\n" ) );
+}
+
+TEST( CompileServer, Serve ) { // NOLINT
+    auto const socket_path =
+        ( std::filesystem::temp_directory_path() / std::format( "axc-test-{}.sock", getpid() ) ).string();
+    CompileServer server( socket_path, Option { .silent = true, .jobs = 2 } );
+    std::thread   thread( [ &server ] { server.run(); } );
+    while ( !std::filesystem::exists( socket_path ) ) {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+
+    std::vector<CompileResult> results( 8 );
+    std::vector<std::thread>   clients;
+    for ( size_t i = 0; i < results.size(); ++i ) {
+        clients.emplace_back( [ &, i ] {
+            CompileRequest const request { .file = "remote.c",
+                                           .system = System::Linux,
+                                           .source = i % 2 ? "int main(void) { return 1 +; }"
+                                                           : "int main(void) { return 2 + 3; }" };
+            results[ i ] = compile_remote( socket_path, request );
+        } );
+    }
+    for ( auto& client : clients ) {
+        client.join();
+    }
+    server.stop();
+    thread.join();
+
+    for ( size_t i = 0; i < results.size(); ++i ) {
+        if ( i % 2 ) {
+            EXPECT_FALSE( results[ i ].success );
+            ASSERT_EQ( results[ i ].diagnostics.size(), 1 );
+            EXPECT_TRUE( results[ i ].diagnostics[ 0 ].starts_with( "Parse error:" ) );
+        } else {
+            EXPECT_TRUE( results[ i ].success );
+            EXPECT_NE( results[ i ].assembly.find( "# file: remote.c" ), std::string::npos );
+        }
+    }
+}
+
+TEST( CompileServer, MessageTooLarge ) { // NOLINT
+    int fds[ 2 ];
+    ASSERT_EQ( ::socketpair( AF_UNIX, SOCK_STREAM, 0, fds ), 0 );
+    auto const header = std::format( "file: a.c\nlength: {}\n\n", max_body_size + 1 );
+    ASSERT_TRUE( write_message( fds[ 1 ], header ) );
+    std::string message;
+    EXPECT_THROW( read_message( fds[ 0 ], message ), std::length_error );
+    ::close( fds[ 0 ] );
+    ::close( fds[ 1 ] );
+}
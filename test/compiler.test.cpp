@@ -0,0 +1,50 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include <filesystem>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "compiler.h"
+
+TEST( Compiler, Source ) { // NOLINT
+    Option option { .silent = true, .input_file = "memory.c", .system = System::Linux };
+    auto   result = compile_source( "int main(void) { return 2 + 3; }", option );
+    EXPECT_TRUE( result.success );
+    EXPECT_TRUE( result.diagnostics.empty() );
+    EXPECT_NE( result.assembly.find( "# file: memory.c" ), std::string::npos );
+    EXPECT_NE( result.assembly.find( "main:" ), std::string::npos );
+    EXPECT_NE( result.assembly.find( ".note.GNU-stack" ), std::string::npos );
+
+    // Nothing is written.
+    EXPECT_FALSE( std::filesystem::exists( "memory.s" ) );
+}
+
+TEST( Compiler, Machine ) { // NOLINT
+    Option option { .silent = true, .machine = Machine::AArch64 };
+    auto   result = compile_source( "int main(void) { return 1; }", option );
+    EXPECT_TRUE( result.success );
+    EXPECT_NE( result.assembly.find( "AArch64" ), std::string::npos );
+}
+
+TEST( Compiler, Errors ) { // NOLINT
+    Option option { .silent = true };
+    auto   result = compile_source( "int main(void) { return 1 +; }", option );
+    EXPECT_FALSE( result.success );
+    EXPECT_TRUE( result.assembly.empty() );
+    ASSERT_EQ( result.diagnostics.size(), 1 );
+    EXPECT_TRUE( result.diagnostics[ 0 ].starts_with( "Parse error:" ) );
+
+    result = compile_source( "int main(void) { return x; }", option );
+    EXPECT_FALSE( result.success );
+    ASSERT_EQ( result.diagnostics.size(), 1 );
+    EXPECT_TRUE( result.diagnostics[ 0 ].starts_with( "Semantic error:" ) );
+}
@@ -9,12 +9,15 @@
 //
 
 #include <print>
+#include <random>
 #include <string>
+#include <string_view>
 
 #include <gtest/gtest.h>
 
 #include "exception.h"
 #include "lexer.h"
+#include "scan.h"
 
 struct TestLexer {
     std::string input;
@@ -143,6 +146,22 @@ TEST( Lexer, Peek ) { // NOLINT
     EXPECT_EQ( token.tok, TokenType::R_PAREN );
 }
 
+TEST( Lexer, Lookahead ) { // NOLINT
+    Lexer lex( std::string_view( "a b c d e f g h i j" ) );
+
+    // A peeked token stays in place while the tokens after it are peeked at, around the ring.
+    for ( char c = 'a'; c < 'h'; ++c ) {
+        auto const& next = lex.peek_token();
+        EXPECT_EQ( lex.peek_token( TokenStream::max_lookahead - 1 ).value, std::string( 1, c + 3 ) );
+        EXPECT_EQ( next.value, std::string( 1, c ) );
+        EXPECT_EQ( &next, &lex.peek_token() );
+        EXPECT_EQ( lex.get_token().value, std::string( 1, c ) );
+    }
+    EXPECT_THROW( lex.peek_token( TokenStream::max_lookahead ), std::out_of_range );
+    EXPECT_EQ( lex.get_token().value, "h" );
+    EXPECT_EQ( lex.peek_token( 2 ).tok, TokenType::Eof );
+}
+
 TEST( Lexer, Constant ) { // NOLINT
     std::vector<TestLexer> const tests = {
         { "1", TokenType::CONSTANT, "1" },
@@ -155,6 +174,97 @@ TEST( Lexer, Constant ) { // NOLINT
     test_Lexer( tests );
 }
 
+TEST( Lexer, View ) { // NOLINT
+    // The lexer reads the text where it is, which need not end with a newline or a null.
+    std::string_view const text = "x = 42L; // end|";
+    Lexer                  lex( text.substr( 0, text.size() - 1 ) );
+    EXPECT_EQ( lex.get_token().value, "x" );
+    EXPECT_EQ( lex.get_token().tok, TokenType::EQUALS );
+    auto token = lex.get_token();
+    EXPECT_EQ( token.tok, TokenType::LONGLITERAL );
+    EXPECT_EQ( token.number, 42 );
+    EXPECT_EQ( lex.get_token().tok, TokenType::SEMICOLON );
+    EXPECT_EQ( lex.get_token().tok, TokenType::Eof );
+
+    Lexer unterminated( std::string_view( "1 /* no end" ) );
+    EXPECT_EQ( unterminated.get_token().number, 1 );
+    EXPECT_THROW( unterminated.get_token(), LexicalException );
+
+    Lexer large( std::string_view( "18446744073709551616" ) );
+    EXPECT_THROW( large.get_token(), LexicalException );
+}
+
+TEST( Lexer, Scanners ) { // NOLINT
+    // Every scanner stops where the plain one does, at each position in text long enough for whole blocks and the
+    // bytes after them.
+    std::mt19937             random( 1 ); // NOLINT
+    std::string const        alphabet = " \t\r\n*/_aZz09@[`{\x80\xff";
+    std::vector<std::string> texts { "", "*", "*/", "/**/", std::string( 40, ' ' ) + "x", std::string( 70, 'a' ) };
+    for ( int i = 0; i < 200; ++i ) {
+        std::string                           text;
+        std::uniform_int_distribution<size_t> length( 0, 100 );
+        std::uniform_int_distribution<size_t> pick( 0, alphabet.size() - 1 );
+        for ( auto n = length( random ); n > 0; --n ) {
+            text.push_back( alphabet[ pick( random ) ] );
+        }
+        texts.push_back( text );
+    }
+
+    auto const  scanners = scan::supported();
+    auto const& scalar = *scanners.front();
+    for ( auto const& text : texts ) {
+        auto const* end = text.data() + text.size();
+        for ( auto const* p = text.data(); p <= end; ++p ) {
+            for ( auto const* scanner : scanners ) {
+                EXPECT_EQ( scanner->skip_blanks( p, end ), scalar.skip_blanks( p, end ) ) << scanner->name;
+                EXPECT_EQ( scanner->find_newline( p, end ), scalar.find_newline( p, end ) ) << scanner->name;
+                EXPECT_EQ( scanner->find_comment_end( p, end ), scalar.find_comment_end( p, end ) ) << scanner->name;
+                EXPECT_EQ( scanner->skip_identifier( p, end ), scalar.skip_identifier( p, end ) ) << scanner->name;
+                EXPECT_EQ( scanner->skip_digits( p, end ), scalar.skip_digits( p, end ) ) << scanner->name;
+                EXPECT_EQ( scanner->count_newlines( p, end ), scalar.count_newlines( p, end ) ) << scanner->name;
+            }
+        }
+    }
+
+    // Lines are still counted past long comments and blanks.
+    std::string const source = "/* " + std::string( 100, '*' ) + " */ a //" + std::string( 100, '-' ) + "\n" +
+                               std::string( 50, ' ' ) + "b";
+    Lexer lex( source );
+    EXPECT_EQ( lex.get_token().location.line, 1 );
+    auto const token = lex.get_token();
+    EXPECT_EQ( token.location.line, 2 );
+    EXPECT_EQ( token.location.col, 51 );
+
+    // And past the lines of long comments, the column going on from the last of them.
+    std::string const comment = "/*" + std::string( 40, '\n' ) + std::string( 70, '*' ) + "\n  */ c";
+    Lexer             after_comment( comment );
+    auto const        next = after_comment.get_token();
+    EXPECT_EQ( next.location.line, 42 );
+    EXPECT_EQ( next.location.col, 6 );
+}
+
+TEST( Lexer, Operators ) { // NOLINT
+    // The longest operator is read, with no spaces needed between operators.
+    std::string_view const text = "<<=>>&&=|||=##=!==-->>=";
+    std::vector<TokenType> const expected { TokenType::COMPOUND_LEFT_SHIFT,
+                                            TokenType::RIGHT_SHIFT,
+                                            TokenType::LOGICAL_AND,
+                                            TokenType::EQUALS,
+                                            TokenType::LOGICAL_OR,
+                                            TokenType::COMPOUND_OR,
+                                            TokenType::HASH_HASH,
+                                            TokenType::EQUALS,
+                                            TokenType::COMPARISON_NOT,
+                                            TokenType::EQUALS,
+                                            TokenType::DECREMENT,
+                                            TokenType::COMPOUND_RIGHT_SHIFT,
+                                            TokenType::Eof };
+    Lexer lex( text );
+    for ( auto const tok : expected ) {
+        EXPECT_EQ( lex.get_token().tok, tok );
+    }
+}
+
 TEST( Lexer, Identifier ) {
     std::vector<TestLexer> const tests = {
         { "      I", TokenType::IDENTIFIER, "I" },
@@ -192,6 +302,13 @@ TEST( Lexer, Keywords ) {
                                            { "static", TokenType::STATIC, "static" },
                                            { "long", TokenType::LONG, "long" } };
     test_Lexer( tests );
+
+    // Words which share a length, first or last character with a keyword.
+    for ( auto const* word : { "in", "intx", "integer", "doo", "d", "lon", "longs", "statics", "cas", "default_" } ) {
+        std::istringstream is( word );
+        Lexer              lex( is );
+        EXPECT_EQ( lex.get_token().tok, TokenType::IDENTIFIER ) << word;
+    }
 }
 
 void test_Lexer( const std::vector<TestLexer>& tests ) {
@@ -205,11 +322,13 @@ void test_Lexer( const std::vector<TestLexer>& tests ) {
             if ( test.tok == TokenType::CONSTANT ) {
                 // std::println("     {} = {}->{}\n", test.input, test.atom, tok.value);
                 EXPECT_EQ( tok.value, test.atom );
+                EXPECT_EQ( tok.number, std::stoull( test.atom ) );
             } else if ( test.tok == TokenType::IDENTIFIER ) {
                 // std::println("     {} -> {}\n", test.input, tok.value);
                 EXPECT_EQ( tok.value, test.atom );
             } else if ( test.tok == TokenType::LONGLITERAL ) {
                 EXPECT_EQ( tok.value, test.atom );
+                EXPECT_EQ( tok.number, std::stoull( test.atom ) );
             }
         } catch ( Exception& e ) {
             FAIL() << "Exception thrown! " << e.get_message() << '\n';
@@ -114,9 +114,10 @@ auto do_parse_tests( std::vector<ParseTests> const& tests ) -> void {
 
     for ( auto const& t : tests ) {
 
+        CompilationContext context( Option { .silent = true } );
         std::istringstream is( t.input );
         Lexer              lex( is );
-        Parser             parser( lex );
+        Parser             parser( lex, context );
 
         std::string result;
         try {
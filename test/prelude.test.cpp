@@ -0,0 +1,76 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "compiler.h"
+#include "prelude.h"
+
+TEST( Prelude, Snapshot ) { // NOLINT
+    CompilationContext context( Option { .silent = true, .input_file = "prelude.h" } );
+    std::istringstream source( "extern int count;\nint add(int a, long b);\nlong get(void);\n" );
+    auto               prelude = compile_prelude( context, source );
+    ASSERT_TRUE( prelude );
+
+    std::stringstream text;
+    write_prelude( text, *prelude );
+    auto const read = read_prelude( text );
+    EXPECT_EQ( read.source, prelude->source );
+    EXPECT_EQ( read.hash, prelude->hash );
+    auto add = read.symbols.find( "add" );
+    ASSERT_TRUE( add );
+    EXPECT_EQ( add->type, Type::FUNCTION );
+    EXPECT_EQ( add->number, 2 );
+    EXPECT_EQ( add->function_type.parameter_types, ( std::vector { Type::INT, Type::LONG } ) );
+    auto count = read.symbols.find( "count" );
+    ASSERT_TRUE( count );
+    EXPECT_EQ( count->storage, StorageClass::Extern );
+    EXPECT_EQ( count->type, Type::INT );
+
+    // Definitions have code, so they can't be in a prelude.
+    CompilationContext defines( Option { .silent = true, .input_file = "prelude.h" } );
+    std::istringstream definition( "int count;\n" );
+    EXPECT_FALSE( compile_prelude( defines, definition ) );
+    EXPECT_TRUE( defines.diagnostics.has_errors() );
+
+    std::istringstream bad( "axc-prelude 2\nsource x.h\nhash 0\nadd none integer 0 none 0 int\n" );
+    EXPECT_THROW( read_prelude( bad ), std::runtime_error );
+}
+
+TEST( Prelude, Compile ) { // NOLINT
+    auto const directory = std::filesystem::temp_directory_path() / "axc-prelude-test";
+    std::filesystem::create_directories( directory );
+    std::ofstream( directory / "prelude.h" ) << "int add(int a, int b);\n";
+
+    CompilationContext context( Option { .silent = true, .input_file = ( directory / "prelude.h" ).string() } );
+    std::ifstream      source( directory / "prelude.h" );
+    auto               prelude = compile_prelude( context, source );
+    ASSERT_TRUE( prelude );
+
+    // The prelude declares add, and the file is not read again when it is included.
+    Option option { .silent = true, .input_file = ( directory / "main.c" ).string(), .system = System::Linux };
+    EXPECT_FALSE( compile_source( "int main(void) { return add(1, 2); }", option ).success );
+    option.prelude = &*prelude;
+    EXPECT_TRUE( compile_source( "int main(void) { return add(1, 2); }", option ).success );
+    EXPECT_TRUE( compile_source( "#include \"prelude.h\"\nint main(void) { return add(1, 2); }", option ).success );
+
+    // When the file has changed, the prelude is out of date and the file is included.
+    EXPECT_TRUE( is_current( *prelude ) );
+    std::ofstream( directory / "prelude.h" ) << "not C";
+    EXPECT_FALSE( is_current( *prelude ) );
+    EXPECT_FALSE( compile_source( "#include \"prelude.h\"\nint main(void) { return add(1, 2); }", option ).success );
+
+    std::filesystem::remove_all( directory );
+}
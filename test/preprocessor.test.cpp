@@ -0,0 +1,170 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "exception.h"
+#include "includeCache.h"
+#include "preprocessor.h"
+
+std::string preprocess( std::string const& input, Option option = Option { .silent = true } ) {
+    CompilationContext context( option );
+    std::istringstream is( input );
+    Preprocessor       preprocessor( is, context );
+    std::string        output;
+    for ( auto token = preprocessor.get_token(); token.tok != TokenType::Eof; token = preprocessor.get_token() ) {
+        output += ( output.empty() ? "" : " " ) + spelling( token );
+    }
+    return output;
+}
+
+TEST( Preprocessor, Macros ) { // NOLINT
+    EXPECT_EQ( preprocess( "int x = 1;" ), "int x = 1 ;" );
+    EXPECT_EQ( preprocess( "#define N 10\nint x = N;" ), "int x = 10 ;" );
+    EXPECT_EQ( preprocess( "#define N M + 1\n#define M 2\nN" ), "2 + 1" );
+    EXPECT_EQ( preprocess( "#define N \\\n  3\nN" ), "3" );
+    EXPECT_EQ( preprocess( "#define N 1\n#undef N\nN" ), "N" );
+
+    // Function-like
+    EXPECT_EQ( preprocess( "#define MAX(a, b) ((a) > (b) ? (a) : (b))\nMAX(x, f(1, 2))" ),
+               "( ( x ) > ( f ( 1 , 2 ) ) ? ( x ) : ( f ( 1 , 2 ) ) )" );
+    EXPECT_EQ( preprocess( "#define F() 1\nF() F" ), "1 F" );
+    EXPECT_EQ( preprocess( "#define F (x)\nF" ), "( x )" );
+    EXPECT_EQ( preprocess( "#define SQ(x) x * x\n#define TWO 2\nSQ(TWO)" ), "2 * 2" );
+    EXPECT_EQ( preprocess( "#define CAT(a, b) a ## b\nCAT(x, 1) CAT(<, <=)" ), "x1 <<=" );
+
+    // A macro is not expanded inside itself.
+    EXPECT_EQ( preprocess( "#define x x + 1\nx" ), "x + 1" );
+    EXPECT_EQ( preprocess( "#define f(a) a + f(a)\nf(2)" ), "2 + f ( 2 )" );
+
+    EXPECT_EQ( preprocess( "N", Option { .silent = true, .defines = { "N=4", "M" } } ), "4" );
+    EXPECT_EQ( preprocess( "M", Option { .silent = true, .defines = { "N=4", "M" } } ), "1" );
+}
+
+TEST( Preprocessor, Conditionals ) { // NOLINT
+    EXPECT_EQ( preprocess( "#if 1\na\n#else\nb\n#endif" ), "a" );
+    EXPECT_EQ( preprocess( "#if 0\na\n#elif 2 > 1\nb\n#else\nc\n#endif" ), "b" );
+    EXPECT_EQ( preprocess( "#define A\n#ifdef A\na\n#endif\n#ifndef A\nb\n#endif" ), "a" );
+    EXPECT_EQ( preprocess( "#if defined(A) || defined B\na\n#else\nb\n#endif" ), "b" );
+    EXPECT_EQ( preprocess( "#define V 3\n#if V * 2 == 6 && !UNDEFINED\na\n#endif" ), "a" );
+
+    // Lines which are skipped need not be tokens, and their conditionals nest.
+    EXPECT_EQ( preprocess( "#if 0\n don't @\n#if 1\nb\n#else\nc\n#endif\n#endif\nd" ), "d" );
+    EXPECT_EQ( preprocess( "#ifdef X\n#error no\n#endif\na" ), "a" );
+
+    EXPECT_THROW( preprocess( "#if 1\na" ), PreprocessorException );
+    EXPECT_THROW( preprocess( "#endif" ), PreprocessorException );
+    EXPECT_THROW( preprocess( "#if 1\n#else\n#else\n#endif" ), PreprocessorException );
+    EXPECT_THROW( preprocess( "#error stop" ), PreprocessorException );
+    EXPECT_THROW( preprocess( "#if 1 / 0\n#endif" ), PreprocessorException );
+}
+
+TEST( Preprocessor, Arithmetic ) { // NOLINT
+    EXPECT_EQ( preprocess( "#if 0 && 1 / 0\na\n#else\nb\n#endif" ), "b" );
+    EXPECT_EQ( preprocess( "#if 1 || 1 / 0\na\n#endif" ), "a" );
+    EXPECT_EQ( preprocess( "#if 1 ? 2 : 1 / 0\na\n#endif" ), "a" );
+    EXPECT_EQ( preprocess( "#if -1 >> 1 == -1 && 1 << 62 > 0\na\n#endif" ), "a" );
+    EXPECT_EQ( preprocess( "#if 18446744073709551615 > 0 && -1 > 0 * 18446744073709551615\na\n#endif" ), "a" );
+
+    // Overflow of intmax_t, and shifts by negative or too large counts, are errors.
+    EXPECT_THROW( preprocess( "#if 9223372036854775807 + 1\n#endif" ), PreprocessorException );
+    EXPECT_THROW( preprocess( "#if 9223372036854775807 * 2\n#endif" ), PreprocessorException );
+    EXPECT_THROW( preprocess( "#if -9223372036854775807 - 2\n#endif" ), PreprocessorException );
+    EXPECT_THROW( preprocess( "#if (-9223372036854775807 - 1) / -1\n#endif" ), PreprocessorException );
+    EXPECT_THROW( preprocess( "#if (-9223372036854775807 - 1) % -1\n#endif" ), PreprocessorException );
+    EXPECT_THROW( preprocess( "#if 1 << 64\n#endif" ), PreprocessorException );
+    EXPECT_THROW( preprocess( "#if 1 >> -1\n#endif" ), PreprocessorException );
+    EXPECT_THROW( preprocess( "#if -1 << 1\n#endif" ), PreprocessorException );
+}
+
+TEST( Preprocessor, Include ) { // NOLINT
+    auto const directory = std::filesystem::temp_directory_path() / "axc-preprocessor-test";
+    std::filesystem::create_directories( directory / "sub" );
+    std::ofstream( directory / "a.h" ) << "#define A 1\n#include \"sub/b.h\"\n";
+    std::ofstream( directory / "sub" / "b.h" ) << "int b;\n";
+    std::ofstream( directory / "sub" / "c.h" ) << "int c;\n";
+
+    Option option { .silent = true, .input_file = ( directory / "main.c" ).string() };
+    EXPECT_EQ( preprocess( "#include \"a.h\"\nA", option ), "int b ; 1" );
+    option.include_paths = { ( directory / "sub" ).string() };
+    EXPECT_EQ( preprocess( "#include <c.h>\nx", option ), "int c ; x" );
+    EXPECT_THROW( preprocess( "#include \"missing.h\"", option ), PreprocessorException );
+
+    // Errors in an included file name it.
+    std::ofstream( directory / "bad.h" ) << "int d;\n#if 1 / 0\n#endif\n";
+    try {
+        preprocess( "#include \"bad.h\"\nx", option );
+        FAIL();
+    } catch ( PreprocessorException const& e ) {
+        EXPECT_EQ( e.get_message(), ( directory / "bad.h" ).string() + ": [2,1] Division by zero in #if" );
+    }
+
+    std::filesystem::remove_all( directory );
+}
+
+TEST( Preprocessor, Location ) { // NOLINT
+    // Tokens keep their lines, and the tokens of a macro have the line it is used on.
+    CompilationContext context( Option { .silent = true } );
+    std::istringstream is( "#define N 1\n\nint\n  N" );
+    Preprocessor       preprocessor( is, context );
+    EXPECT_EQ( preprocessor.get_token().location.line, 3 );
+    EXPECT_EQ( preprocessor.get_token().location.line, 4 );
+
+    // Lines in comments are counted, and columns are those of the start of the token.
+    std::istringstream commented( "/* one\n   two */ int main" );
+    Preprocessor       after_comment( commented, context );
+    auto const         type = after_comment.get_token();
+    EXPECT_EQ( type.location.line, 2 );
+    EXPECT_EQ( type.location.col, 11 );
+    auto const name = after_comment.get_token();
+    EXPECT_EQ( name.location.line, 2 );
+    EXPECT_EQ( name.location.col, 15 );
+}
+
+TEST( Preprocessor, IncludeCache ) { // NOLINT
+    auto const directory = std::filesystem::temp_directory_path() / "axc-include-cache-test";
+    std::filesystem::create_directories( directory );
+    std::ofstream( directory / "guard.h" ) << "#ifndef GUARD_H\n#define GUARD_H\nint g;\n#endif\n";
+    std::ofstream( directory / "once.h" ) << "#pragma once\nint o;\n";
+    std::ofstream( directory / "open.h" ) << "#ifndef OPEN_H\n#define OPEN_H\n#endif\nint p;\n";
+
+    IncludeCache cache;
+    Option       option { .silent = true, .input_file = ( directory / "main.c" ).string(), .include_cache = &cache };
+    auto const   source = "#include \"guard.h\"\n#include \"once.h\"\n#include \"guard.h\"\n#include \"once.h\"\n"
+                          "#include \"open.h\"\n#include \"open.h\"\n";
+    EXPECT_EQ( preprocess( source, option ), "int g ; int o ; int p ; int p ;" );
+    EXPECT_EQ( cache.misses(), 3 );
+    EXPECT_EQ( cache.hits(), 1 ); // open.h, as the others are skipped without looking for them
+
+    // Another compilation uses the cached files.
+    EXPECT_EQ( preprocess( source, option ), "int g ; int o ; int p ; int p ;" );
+    EXPECT_EQ( cache.misses(), 3 );
+    EXPECT_EQ( cache.hits(), 5 );
+
+    // A file that changes is read again.
+    std::ofstream( directory / "once.h" ) << "#pragma once\nint changed;\n";
+    auto const changed = std::filesystem::last_write_time( directory / "once.h" ) + std::chrono::seconds( 1 );
+    std::filesystem::last_write_time( directory / "once.h", changed );
+    EXPECT_EQ( preprocess( source, option ), "int g ; int changed ; int p ; int p ;" );
+    EXPECT_EQ( cache.misses(), 4 );
+
+    // An #else means the file has text when the macro is defined, so it is not a guard.
+    std::ofstream( directory / "else.h" ) << "#ifndef ELSE_H\n#define ELSE_H\n#else\nint e;\n#endif\n";
+    EXPECT_EQ( preprocess( "#include \"else.h\"\n#include \"else.h\"\n", option ), "int e ;" );
+
+    std::filesystem::remove_all( directory );
+}
@@ -0,0 +1,130 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 16/10/2026.
+//
+
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "compilationContext.h"
+#include "lexer.h"
+#include "parser.h"
+#include "printerTAC.h"
+#include "semanticAnalyser.h"
+#include "symbolTable.h"
+#include "tacGen.h"
+#include "tacPasses.h"
+
+struct PassTests {
+    std::string input;
+    std::string output; // the kinds of instructions left in main, with constant return values
+};
+
+void do_pass_tests( std::vector<PassTests> const& tests, Option const& option );
+
+TEST( TacPasses, Pipeline ) { // NOLINT
+    Option option;
+    EXPECT_TRUE( tac_pipeline( option ).empty() );
+    option.opt_level = 1;
+    EXPECT_EQ( tac_pipeline( option ), std::vector<std::string>( { "constfold" } ) );
+    option.opt_level = 2;
+    EXPECT_EQ( tac_pipeline( option ), std::vector<std::string>( { "constfold", "dce" } ) );
+    option.passes = { "dce" };
+    EXPECT_EQ( tac_pipeline( option ), std::vector<std::string>( { "dce" } ) );
+    CompilationContext context( option );
+    EXPECT_EQ( make_tac_passes( context ).size(), 1 );
+
+    context.option.passes = { "unknown" };
+    EXPECT_THROW( make_tac_passes( context ), std::runtime_error );
+}
+
+TEST( TacPasses, ConstantFold ) { // NOLINT
+    std::vector<PassTests> tests = {
+        { "int main(void) { return 2 + 3 * 4; }", "Copy; Copy; Return 14; Return 0;" },
+        { "int main(void) { return -(~1); }", "Copy; Copy; Return 2; Return 0;" },
+        { "int main(void) { return !0 + (3 < 4); }", "Copy; Copy; Copy; Return 2; Return 0;" },
+        { "int main(void) { return 2147483647 + 1; }", "Copy; Return -2147483648; Return 0;" },
+        { "int main(void) { return 7 % 3 << 4 >> 1; }", "Copy; Copy; Copy; Return 8; Return 0;" },
+        // Left for run time
+        { "int main(void) { return 1 / 0; }", "Binary; Return; Return 0;" },
+        { "int main(void) { return 1 << 40; }", "Binary; Return; Return 0;" },
+        { "int main(void) { int a = 1; return a + 2; }", "Copy; Copy; Copy; Return 3; Return 0;" },
+    };
+    Option option;
+    option.passes = { "constfold" };
+    do_pass_tests( tests, option );
+}
+
+TEST( TacPasses, DeadCode ) { // NOLINT
+    std::vector<PassTests> tests = {
+        { "int main(void) { return 1; return 2; }", "Return 1;" },
+        { "int main(void) { if (0) return 1; return 2; }", "Return 2;" },
+        { "int main(void) { if (1) return 1; return 2; }", "Return 1;" },
+        { "int main(void) { int a = 0; while (0) a = a + 1; return a; }", "Copy; Copy; Return;" },
+    };
+    Option option;
+    option.opt_level = 2;
+    do_pass_tests( tests, option );
+}
+
+std::string instruction_kinds( tac::Program program ) {
+    std::string result;
+    for ( auto const& item : program->top_level ) {
+        auto const* function = std::get_if<tac::FunctionDef>( &item );
+        if ( function == nullptr || ( *function )->name != "main" ) {
+            continue;
+        }
+        PrinterTAC printer;
+        for ( auto const& instr : ( *function )->instructions ) {
+            // The first word of the instruction, and the constant returned.
+            auto text = std::visit( [ &printer ]( auto&& i ) -> std::string { return i->accept( &printer ); }, instr );
+            std::istringstream is( text );
+            std::string        kind;
+            is >> kind;
+            result += kind;
+            if ( auto const* ret = std::get_if<tac::Return>( &instr ) ) {
+                if ( auto const* c = std::get_if<tac::ConstantInt>( &( *ret )->value ) ) {
+                    result += std::format( " {}", ( *c )->value );
+                }
+            }
+            result += "; ";
+        }
+    }
+    if ( !result.empty() ) {
+        result.pop_back();
+    }
+    return result;
+}
+
+auto do_pass_tests( std::vector<PassTests> const& tests, Option const& option ) -> void {
+    for ( auto const& t : tests ) {
+        CompilationContext context( option );
+        context.logger->set_level( spdlog::level::off );
+        std::istringstream is( t.input );
+        Lexer              lex( is );
+        Parser             parser( lex, context );
+
+        try {
+            std::cout << t.input << std::endl;
+            auto             ast = parser.parse();
+            SemanticAnalyser analyser( context );
+            analyser.analyse( ast );
+            TacGen tac_generator( context );
+            auto   program = tac_generator.generate( ast );
+
+            auto passes = make_tac_passes( context );
+            passes.run( program );
+            EXPECT_EQ( instruction_kinds( program ), t.output );
+        } catch ( std::exception& e ) {
+            std::println( "Exception: {}", e.what() );
+            FAIL();
+        }
+    }
+}
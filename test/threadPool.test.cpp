@@ -0,0 +1,96 @@
+//
+// AXC - C Compiler
+//
+// Copyright (c) 2025.
+//
+
+//
+// Created by Alex Kowalenko on 17/10/2026.
+//
+
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "jobServer.h"
+#include "threadPool.h"
+
+TEST( ThreadPool, RunsAllTasks ) { // NOLINT
+    ThreadPool       pool( 4 );
+    std::vector<int> results( 1000 );
+    for ( int i = 0; i < 1000; ++i ) {
+        pool.submit( [ &results, i ] { results[ i ] = i * i; } );
+    }
+    pool.wait();
+    for ( int i = 0; i < 1000; ++i ) {
+        EXPECT_EQ( results[ i ], i * i );
+    }
+}
+
+TEST( ThreadPool, NestedTasks ) { // NOLINT
+    ThreadPool       pool( 3 );
+    std::atomic<int> count { 0 };
+    for ( int i = 0; i < 10; ++i ) {
+        pool.submit( [ & ] {
+            for ( int j = 0; j < 10; ++j ) {
+                pool.submit( [ & ] { ++count; } );
+            }
+        } );
+    }
+    pool.wait();
+    EXPECT_EQ( count, 100 );
+
+    // The pool can be used again.
+    pool.submit( [ & ] { ++count; } );
+    pool.wait();
+    EXPECT_EQ( count, 101 );
+}
+
+TEST( ThreadPool, Exception ) { // NOLINT
+    ThreadPool       pool( 2 );
+    std::atomic<int> count { 0 };
+    pool.submit( [] { throw std::runtime_error( "task failed" ); } );
+    pool.submit( [ & ] { ++count; } );
+    EXPECT_THROW( pool.wait(), std::runtime_error );
+    EXPECT_EQ( count, 1 );
+}
+
+TEST( ThreadPool, JobServer ) { // NOLINT
+    int fds[ 2 ];
+    ASSERT_EQ( pipe( fds ), 0 );
+    EXPECT_FALSE( JobServer::from_makeflags( "-j4" ) );
+    EXPECT_FALSE( JobServer::from_makeflags( "--jobserver-auth=99,98" ) ); // not open
+    auto jobs = JobServer::from_makeflags( std::format( " -j3 --jobserver-auth={},{}", fds[ 0 ], fds[ 1 ] ) );
+    ASSERT_TRUE( jobs );
+    ASSERT_EQ( write( fds[ 1 ], "ab", 2 ), 2 ); // make -j3 has 2 tokens, and its own slot
+
+    std::atomic<int> running { 0 };
+    std::atomic<int> most { 0 };
+    {
+        ThreadPool pool( 6, jobs.get() );
+        for ( int i = 0; i < 30; ++i ) {
+            pool.submit( [ & ] {
+                auto const now = ++running;
+                for ( auto seen = most.load(); seen < now && !most.compare_exchange_weak( seen, now ); ) {}
+                std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+                --running;
+            } );
+        }
+        pool.wait();
+    }
+    EXPECT_LE( most, 3 );
+    EXPECT_GE( most, 2 );
+
+    // The tokens are given back.
+    char tokens[ 3 ];
+    EXPECT_EQ( read( fds[ 0 ], tokens, 3 ), 2 );
+    jobs.reset();
+    close( fds[ 0 ] );
+    close( fds[ 1 ] );
+}
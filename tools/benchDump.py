@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+#
+#  AXC - C Compiler
+#
+#  Copyright (c) 2025.
+#
+
+# Benchmark the cost of the IR dumps: compile a large input from genProgram.py quietly (the default) and with every
+# dump turned on, and report the time saved.
+
+import argparse
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def generate_program(size, seed, output):
+    """Write a program in the C subset accepted by axc of about size bytes, with genProgram.py"""
+    generator = os.path.join(os.path.dirname(os.path.abspath(__file__)), "genProgram.py")
+    subprocess.run([sys.executable, generator, "--size", size, "--seed", str(seed), "-o", output], check=True)
+
+
+def time_compile(axc, source, flags, repeat):
+    """Return the wall clock times of compiling source with the flags"""
+    times = []
+    for _ in range(repeat):
+        start = time.perf_counter()
+        result = subprocess.run([axc, "-s"] + flags + [source], stdout=subprocess.DEVNULL)
+        times.append(time.perf_counter() - start)
+        if result.returncode != 0:
+            print(f"Compile failed: {' '.join([axc] + flags + [source])}")
+            sys.exit(result.returncode)
+    return times
+
+
+def main():
+    app = argparse.ArgumentParser(description="Benchmark axc with and without IR dumps")
+    app.add_argument('--axc', help='path to axc_comp.', default="axc_comp")
+    app.add_argument('--size', help='size of the program generated, e.g. 512K or 2M.', default="2M")
+    app.add_argument('--seed', help='random seed of the program generated.', type=int, default=1)
+    app.add_argument('--repeat', help='number of runs for each configuration.', type=int, default=5)
+    args = app.parse_args()
+
+    dump_all = ["--dump-ast", "--dump-sema", "--dump-tac", "--dump-asm=all"]
+    with tempfile.TemporaryDirectory() as tmp:
+        source = os.path.join(tmp, "large.c")
+        generate_program(args.size, args.seed, source)
+        print(f"Input: {os.path.getsize(source) / 1024:.0f} KB")
+
+        quiet = statistics.median(time_compile(args.axc, source, [], args.repeat))
+        dumped = statistics.median(time_compile(args.axc, source, dump_all, args.repeat))
+
+    print(f"{'quiet (default)':<20} {quiet:8.3f} s")
+    print(f"{'all dumps':<20} {dumped:8.3f} s")
+    print(f"{'saving':<20} {dumped - quiet:8.3f} s ({100 * (dumped - quiet) / dumped:.1f}%)")
+
+
+if __name__ == "__main__":
+    main()
@@ -12,6 +12,7 @@ template_file = "class_template.ht"
 sum_type_template_file = "sum_template.ht"
 template_visit_file = "visitor_template.ht"
 includes_file = "includes.h"
+counts_template_file = "counts_template.ht"
 
 def define_ast(output_dir, namespace_name, types, sum_types):
     """Generate AST class definitions using specification and jinja2"""
@@ -22,13 +23,13 @@ def define_ast(output_dir, namespace_name, types, sum_types):
     with open(template_file) as f:
         template = jinja2.Template(f.read())
 
-    for class_name, members in types.items():
+    for index, (class_name, members) in enumerate(types.items()):
         print(class_name)
         print(members)
         file_name = class_name.lower()
 
         with open(os.path.join(output_dir, "{}.h".format(file_name)), 'w') as f:
-            f.write(template.render(base_name=class_name, members=members, namespace=namespace_name))
+            f.write(template.render(base_name=class_name, members=members, namespace=namespace_name, index=index))
 
     with open(sum_type_template_file) as f:
         template = jinja2.Template(f.read())
@@ -47,6 +48,13 @@ def define_ast(output_dir, namespace_name, types, sum_types):
     with open(os.path.join(output_dir, "visitor.h"), 'w') as fv:
         fv.write(visitor.render(type_items=types.items(), namespace=namespace_name))
 
+    # node counts for --mem-report
+    with open(counts_template_file) as f:
+        counts = jinja2.Template(f.read())
+
+    with open(os.path.join(output_dir, "counts.h"), 'w') as fc:
+        fc.write(counts.render(type_items=types.items(), namespace=namespace_name))
+
     # include file
     with open(os.path.join(output_dir, includes_file), 'w') as f:
         for class_name, members in sum_types.items():
@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+#
+#  AXC - C Compiler
+#
+#  Copyright (c) 2025.
+#
+
+# Generate synthetic programs in the C subset accepted by axc, for benchmarks, scaling and stress tests.
+#
+#   genProgram.py --functions 100 --statements 20 -o large.c
+#   genProgram.py --size 100M --expr-depth 6 --nesting 4 -o huge.c
+
+import argparse
+import random
+import sys
+
+BINARY_OPS = ["+", "-", "*", "&", "|", "^", "<", ">", "<=", ">=", "==", "!=", "&&", "||"]
+UNARY_OPS = ["-", "~", "!"]
+COMPOUND_OPS = ["+=", "-=", "*=", "&=", "|=", "^="]
+
+
+def parse_size(text):
+    """Parse a size such as 512, 64K or 100M in bytes"""
+    units = {"K": 1024, "M": 1024 * 1024, "G": 1024 * 1024 * 1024}
+    text = text.strip().upper().rstrip("B")
+    if text and text[-1] in units:
+        return int(float(text[:-1]) * units[text[-1]])
+    return int(text)
+
+
+class Generator:
+    """Generates the functions of a program, keeping the names in scope"""
+
+    def __init__(self, args, out):
+        self.args = args
+        self.out = out
+        self.random = random.Random(args.seed)
+        self.written = 0
+        self.functions = []  # (name, number of parameters)
+        self.globals = []
+        self.counter = 0
+
+    def write(self, text):
+        self.out.write(text)
+        self.written += len(text)
+
+    def name(self, prefix):
+        self.counter += 1
+        return f"{prefix}{self.counter}"
+
+    def expr(self, depth, variables):
+        """An expression of at most depth levels of operators"""
+        r = self.random
+        if depth <= 0 or r.random() < 0.2:
+            if r.random() < 0.6:
+                return r.choice(variables)
+            return str(r.randint(0, 1000))
+        choice = r.random()
+        if choice < 0.6:
+            op = r.choice(BINARY_OPS)
+            return f"({self.expr(depth - 1, variables)} {op} {self.expr(depth - 1, variables)})"
+        if choice < 0.7:
+            # keep the divisor away from zero
+            op = r.choice(["/", "%"])
+            return f"({self.expr(depth - 1, variables)} {op} ({self.expr(depth - 1, variables)} | 1))"
+        if choice < 0.75:
+            op = r.choice(["<<", ">>"])
+            return f"({self.expr(depth - 1, variables)} {op} {r.randint(0, 7)})"
+        if choice < 0.85:
+            return f"{r.choice(UNARY_OPS)}({self.expr(depth - 1, variables)})"
+        if choice < 0.93:
+            return f"({self.expr(depth - 1, variables)} ? {self.expr(depth - 1, variables)} : " \
+                   f"{self.expr(depth - 1, variables)})"
+        if self.functions:
+            function, params = r.choice(self.functions)
+            arguments = ", ".join(self.expr(min(depth - 2, 1), variables) for _ in range(params))
+            return f"{function}({arguments})"
+        return r.choice(variables)
+
+    def statement(self, indent, nesting, variables, assignable):
+        """A statement, with nested blocks while nesting is above zero"""
+        r = self.random
+        a = self.args
+        pad = "    " * indent
+        choice = r.random() if nesting > 0 else r.random() * 0.5
+        if choice < 0.35:
+            op = r.choice(["="] + COMPOUND_OPS)
+            return f"{pad}{r.choice(assignable)} {op} {self.expr(a.expr_depth, variables)};\n"
+        if choice < 0.5:
+            return f"{pad}{r.choice(assignable)}{r.choice(['++', '--'])};\n"
+        if choice < 0.62:
+            buf = f"{pad}if ({self.expr(a.expr_depth, variables)}) {{\n"
+            buf += self.block(indent + 1, nesting - 1, variables, assignable)
+            buf += f"{pad}}} else {{\n"
+            buf += self.block(indent + 1, nesting - 1, variables, assignable)
+            return buf + f"{pad}}}\n"
+        if choice < 0.72:
+            i = self.name("i")
+            buf = f"{pad}for (int {i} = 0; {i} < {r.randint(1, 10)}; {i} = {i} + 1) {{\n"
+            buf += self.block(indent + 1, nesting - 1, variables + [i], assignable)
+            return buf + f"{pad}}}\n"
+        if choice < 0.8:
+            w = self.name("w")
+            buf = f"{pad}{{\n{pad}    int {w} = {r.randint(1, 10)};\n"
+            buf += f"{pad}    while ({w} > 0) {{\n"
+            buf += self.block(indent + 2, nesting - 1, variables + [w], assignable)
+            buf += f"{pad}        {w} = {w} - 1;\n{pad}    }}\n"
+            return buf + f"{pad}}}\n"
+        if choice < 0.86:
+            d = self.name("d")
+            buf = f"{pad}{{\n{pad}    int {d} = {r.randint(1, 10)};\n{pad}    do {{\n"
+            buf += self.block(indent + 2, nesting - 1, variables + [d], assignable)
+            buf += f"{pad}        {d} = {d} - 1;\n{pad}    }} while ({d} > 0);\n"
+            return buf + f"{pad}}}\n"
+        if choice < 0.94:
+            buf = f"{pad}switch ({self.expr(a.expr_depth, variables)}) {{\n"
+            for case in r.sample(range(a.switch_cases * 4), a.switch_cases):
+                buf += f"{pad}case {case}:\n"
+                buf += self.block(indent + 1, nesting - 1, variables, assignable)
+                buf += f"{pad}    break;\n"
+            buf += f"{pad}default:\n"
+            buf += self.block(indent + 1, nesting - 1, variables, assignable)
+            return buf + f"{pad}}}\n"
+        buf = f"{pad}{{\n"
+        buf += self.block(indent + 1, nesting - 1, variables, assignable)
+        return buf + f"{pad}}}\n"
+
+    def block(self, indent, nesting, variables, assignable):
+        count = self.random.randint(1, 3)
+        return "".join(self.statement(indent, nesting, variables, assignable) for _ in range(count))
+
+    def function(self):
+        r = self.random
+        a = self.args
+        name = f"function_{len(self.functions)}"
+        params = [f"p{i}" for i in range(r.randint(0, a.args))]
+        locals_ = [f"v{i}" for i in range(a.locals)]
+        buf = f"int {name}({', '.join('int ' + p for p in params) if params else 'void'}) {{\n"
+        for v in locals_:
+            buf += f"    int {v} = {r.randint(0, 100)};\n"
+        variables = params + locals_ + self.globals
+        assignable = locals_ + self.globals
+        for _ in range(a.statements):
+            buf += self.statement(1, a.nesting, variables, assignable)
+        buf += f"    return {self.expr(a.expr_depth, variables)};\n}}\n\n"
+        self.write(buf)
+        self.functions.append((name, len(params)))
+
+    def program(self):
+        a = self.args
+        for g in range(a.globals):
+            name = f"g{g}"
+            self.write(f"{'static ' if g % 2 else ''}int {name} = {self.random.randint(0, 100)};\n")
+            self.globals.append(name)
+        self.write("\n")
+        size = parse_size(a.size) if a.size else 0
+        while len(self.functions) < a.functions or self.written < size:
+            self.function()
+        # main calls the last few functions
+        calls = [f"{f}({', '.join(str(i + 1) for i in range(p))})" for f, p in self.functions[-4:]]
+        self.write(f"int main(void) {{\n    return ({' + '.join(calls)}) & 255;\n}}\n")
+
+
+def main():
+    app = argparse.ArgumentParser(description="Generate a synthetic program for axc")
+    app.add_argument('-o', '--output', help='output file (default stdout).')
+    app.add_argument('--functions', help='number of functions.', type=int, default=10)
+    app.add_argument('--statements', help='statements per function.', type=int, default=10)
+    app.add_argument('--expr-depth', help='maximum depth of expressions.', type=int, default=3)
+    app.add_argument('--nesting', help='maximum nesting of blocks.', type=int, default=2)
+    app.add_argument('--switch-cases', help='cases in each switch.', type=int, default=4)
+    app.add_argument('--globals', help='number of global variables.', type=int, default=4)
+    app.add_argument('--locals', help='local variables per function.', type=int, default=4)
+    app.add_argument('--args', help='maximum parameters per function, above 6 go on the stack.', type=int,
+                     default=8)
+    app.add_argument('--size', help='keep adding functions until the output is this size, e.g. 64K or 100M.')
+    app.add_argument('--seed', help='random seed, the same seed gives the same program.', type=int, default=1)
+    args = app.parse_args()
+
+    if args.output:
+        with open(args.output, "w") as out:
+            Generator(args, out).program()
+    else:
+        Generator(args, sys.stdout).program()
+
+
+if __name__ == "__main__":
+    main()